@@ -0,0 +1,8 @@
+// ============================================================
+
+#pragma once
+
+#include "dsp/JunoVoice.hpp"
+
+
+// ============================================================
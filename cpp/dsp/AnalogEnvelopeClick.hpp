@@ -0,0 +1,107 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+
+class AnalogEnvelopeClick {
+public:
+    struct ClickParams {
+        bool isRetrigger = false;
+        float releaseLevel = 0.0f;
+        float attackTime = 0.01f;
+        float sampleRate = 44100.0f;
+    };
+
+    AnalogEnvelopeClick() { setSampleRate(_sampleRate); }
+
+    void setSampleRate(float sr) {
+        _sampleRate = sr;
+        _lpFilter.setCutoff(12000.0f, _sampleRate);
+        // exp(-t * 10000) advances by this factor per sample.
+        _decayStep = std::exp(-10000.0f / _sampleRate);
+    }
+
+    void setClickAmount(float amount) {
+        _clickAmount = std::clamp(amount, 0.0f, 2.0f);
+    }
+
+    void triggerClick(const ClickParams &p) {
+        if (!p.isRetrigger) {
+            reset();
+            return;
+        }
+        _clickAmp = p.releaseLevel * 0.5f;
+        if (p.releaseLevel < 0.01f) {
+            _clickAmp *= 0.3f;
+        }
+        _clickAmp *= (0.01f / std::max(p.attackTime, 0.001f));
+        _clickDuration = std::min(0.0005f, p.attackTime * 0.1f);
+        _clickPhase = 0.0f;
+        _decay = 1.0f;
+        _active = true;
+    }
+
+    void reset() {
+        _clickAmp = 0.0f;
+        _clickPhase = 0.0f;
+        _active = false;
+    }
+
+    float process() {
+        if (!_active || _clickAmp <= 0.0001f) {
+            return 0.0f;
+        }
+        float t = _clickPhase;
+        float click = 0.0f;
+        if (t == 0.0f) {
+            click = _clickAmp;
+        } else if (t < _clickDuration) {
+            click = _clickAmp * _decay;
+            if (t > _clickDuration * 0.3f) {
+                click *= -0.2f;
+            }
+        } else {
+            _active = false;
+        }
+        click *= _clickAmount;
+        _clickPhase += 1.0f / _sampleRate;
+        _decay *= _decayStep;
+        return _lpFilter.process(click);
+    }
+
+    // Adds `n` samples of the click to `out`; returns at once when idle.
+    void processBlock(float *out, int n) {
+        for (int i = 0; i < n && _active; ++i) out[i] += process();
+    }
+
+private:
+    class OnePoleLowpass {
+    public:
+        void setCutoff(float freq, float sr) {
+            _alpha = 1.0f - std::exp(-2.0f * M_PI * freq / sr);
+        }
+        float process(float in) {
+            _z = in * _alpha + _z * (1.0f - _alpha);
+            return _z;
+        }
+    private:
+        float _alpha = 0.1f;
+        float _z = 0.0f;
+    };
+
+    float _sampleRate = 44100.0f;
+    float _clickAmount = 1.0f;
+    float _clickAmp = 0.0f;
+    float _clickDuration = 0.0002f;
+    float _clickPhase = 0.0f;
+    float _decay = 1.0f;
+    float _decayStep = 0.0f;
+    bool _active = false;
+    OnePoleLowpass _lpFilter;
+};
+
+
+// ============================================================
@@ -0,0 +1,89 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "dsp/FastMath.hpp"
+
+// Quality tiers for the analog models (IR3109 OTA filter, JFET VCA).
+//
+// Each tier is a policy type whose static functions the model code is
+// templated on, so every tier compiles to its own inlined inner loop and
+// choosing one costs a single dispatch per block (see withAnalogTier()).
+// The tiers share the model state, so switching between blocks is
+// seamless.
+//
+//   Ultra     the reference models: std::tanh, std::exp, std::pow.
+//   Standard  the FastMath kernels (tanh within 2.5e-7, exp within ~1e-6
+//             relative over the converter's range), squares instead of
+//             pow(); otherwise as Ultra. The engine's default.
+//   Eco       tanh as a [3/2] Pade fit (max error ~0.024), exp from a cubic
+//             in the exponent bits (relative error ~1.5e-4) and a single
+//             JFET operating-point pass.
+enum class AnalogTier {
+    Eco,
+    Standard,
+    Ultra
+};
+
+struct UltraModel {
+    static constexpr AnalogTier kTier = AnalogTier::Ultra;
+    static constexpr int kJfetIterations = 3;
+
+    static float tanh(float x) { return std::tanh(x); }
+    static float exp(float x) { return std::exp(x); }
+    static float square(float x) { return std::pow(x, 2.0f); }
+};
+
+struct StandardModel {
+    static constexpr AnalogTier kTier = AnalogTier::Standard;
+    static constexpr int kJfetIterations = 3;
+
+    static float tanh(float x) { return fastmath::tanh(x); }
+    static float exp(float x) { return fastmath::exp(x); }
+    static float square(float x) { return x * x; }
+};
+
+struct EcoModel {
+    static constexpr AnalogTier kTier = AnalogTier::Eco;
+    static constexpr int kJfetIterations = 1;
+
+    static float tanh(float x) {
+        x = std::clamp(x, -3.0f, 3.0f);
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    static float exp(float x) {
+        // 2^(x * log2 e): the integer part goes straight into the exponent
+        // bits, the fraction through a cubic.
+        const float t = std::clamp(x * 1.44269504f, -126.0f, 127.0f);
+        const float whole = std::floor(t);
+        const float f = t - whole;
+        const float mantissa = 1.0f + f * (0.69583356f + f * (0.22606716f + f * 0.078024521f));
+        const std::uint32_t bits = static_cast<std::uint32_t>(static_cast<int>(whole) + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return mantissa * scale;
+    }
+
+    static float square(float x) { return x * x; }
+};
+
+// Calls fn(Model{}) with the policy type for `tier`.
+template <typename Fn>
+decltype(auto) withAnalogTier(AnalogTier tier, Fn&& fn) {
+    switch (tier) {
+        case AnalogTier::Eco:      return fn(EcoModel{});
+        case AnalogTier::Standard: return fn(StandardModel{});
+        case AnalogTier::Ultra:    break;
+    }
+    return fn(UltraModel{});
+}
+
+
+// ============================================================
@@ -6,6 +6,9 @@
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+
+#include "dsp/FastMath.hpp"
 
 class BBDChorus {
 public:
@@ -29,6 +32,10 @@ public:
 
     Mode mode() const { return _mode; }
 
+    // Frames after the input goes silent until the delay line has played
+    // out; past that only the clock noise is left.
+    int tailFrames() const { return static_cast<int>(_buffer.size()); }
+
     void reset() {
         std::fill(_buffer.begin(), _buffer.end(), 0.0f);
         _writeIndex = 0;
@@ -56,8 +63,8 @@ public:
         const float lfoRateR = 1.2f;  // Hz
 
         // Simple sine LFOs
-        float lfoL = std::sin(2.0f * static_cast<float>(M_PI) * _lfoPhaseL);
-        float lfoR = std::sin(2.0f * static_cast<float>(M_PI) * _lfoPhaseR);
+        float lfoL = fastmath::sin2pi(_lfoPhaseL);
+        float lfoR = fastmath::sin2pi(_lfoPhaseR);
 
         float delayL = baseDelay + depth * lfoL;
         float delayR = baseDelay + depth * lfoR;
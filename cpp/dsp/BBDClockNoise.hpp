@@ -0,0 +1,88 @@
+// ============================================================
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "dsp/FastMath.hpp"
+
+class BBDClockNoise {
+public:
+    void setSampleRate(float sr) {
+        _sr = sr;
+        _edgeFilter.setCutoff(15000.0f, _sr);
+        _feedFilter.setCutoff(8000.0f, _sr);
+        _clockInc = _clockRate / _sr;
+    }
+
+    void setClockRate(float clockHz) {
+        _clockRate = clockHz;
+        _clockInc = _clockRate / _sr;
+    }
+
+    void setJitterAmount(float amt) { _jitterAmount = amt; }
+
+    float process() {
+        float jitter = (_whiteNoise.next() - 0.5f) * 0.0002f * _jitterAmount;
+        _clockInc = (_clockRate / _sr) * (1.0f + jitter);
+        _clockPhase += _clockInc;
+        if (_clockPhase >= 1.0f) {
+            _clockPhase -= 1.0f;
+            _clockEdge = !_clockEdge;
+            float spike = _edgeFilter.process(_clockEdge ? 1.0f : -1.0f);
+            spike *= 0.01f;
+            _lastSpike = spike;
+        }
+
+        float clockFeed = fastmath::sin2pi(_clockPhase) * _clockRate;
+        clockFeed = _feedFilter.process(clockFeed) * 0.005f;
+
+        float pumpNoise = fastmath::sin2pi(_clockPhase * 0.5f) * 0.003f;
+
+        float noise = _lastSpike + clockFeed + pumpNoise;
+        return noise;
+    }
+
+private:
+    class OnePoleFilter {
+    public:
+        void setCutoff(float f, float sr) {
+            _alpha = 1.0f - std::exp(-2.0f * M_PI * f / sr);
+        }
+        float process(float in) {
+            _z = in * _alpha + _z * (1.0f - _alpha);
+            return _z;
+        }
+    private:
+        float _alpha = 0.1f;
+        float _z = 0.0f;
+    };
+
+    class WhiteNoise {
+    public:
+        float next() {
+            _state ^= _state << 13;
+            _state ^= _state >> 17;
+            _state ^= _state << 5;
+            return static_cast<float>(_state) / static_cast<float>(0xFFFFFFFFu);
+        }
+    private:
+        uint32_t _state = 0x12345678u;
+    };
+
+    float _sr = 44100.0f;
+    float _clockRate = 15000.0f;
+    float _clockInc = 0.0f;
+    float _clockPhase = 0.0f;
+    bool _clockEdge = false;
+    float _lastSpike = 0.0f;
+    float _jitterAmount = 1.0f;
+
+    OnePoleFilter _edgeFilter;
+    OnePoleFilter _feedFilter;
+    WhiteNoise _whiteNoise;
+};
+
+
+// ============================================================
@@ -0,0 +1,43 @@
+// ============================================================
+
+#pragma once
+
+#include <cmath>
+
+class CableCapacitance {
+public:
+    void setCableLength(float meters, float sr) {
+        _sr = sr;
+        _C = meters * 80e-12f;
+        float R = 1000.0f;
+        _cutoffHz = 1.0f / (2.0f * M_PI * R * _C);
+        float x = std::exp(-2.0f * M_PI * _cutoffHz / _sr);
+        _alpha = 1.0f - x;
+        _skinEffect = meters * 0.01f;
+    }
+
+    float process(float input) {
+        _state += (input - _state) * _alpha;
+        float out = _state;
+        if (_skinEffect > 0.0f) {
+            float f2 = 10000.0f / (1.0f + _skinEffect * 10.0f);
+            float x2 = std::exp(-2.0f * M_PI * f2 / _sr);
+            float a2 = 1.0f - x2;
+            _state2 += (_state - _state2) * a2;
+            out = _state2;
+        }
+        return out;
+    }
+
+private:
+    float _sr = 44100.0f;
+    float _C = 100e-12f;
+    float _cutoffHz = 16000.0f;
+    float _alpha = 0.1f;
+    float _skinEffect = 0.0f;
+    float _state = 0.0f;
+    float _state2 = 0.0f;
+};
+
+
+// ============================================================
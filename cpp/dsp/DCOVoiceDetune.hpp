@@ -0,0 +1,69 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "dsp/FastMath.hpp"
+
+class DCOVoiceDetune {
+public:
+    void init(float baseFreq, int voiceIndex, float sampleRate) {
+        _baseFreq = baseFreq;
+        _sampleRate = sampleRate;
+        constexpr std::array<float, 6> voiceOffsets = {
+            0.9975f, 1.0000f, 1.0025f, 0.9985f, 1.0015f, 0.9995f
+        };
+        _staticDetune = voiceOffsets[voiceIndex % voiceOffsets.size()];
+        _driftLFOHz = 0.02f + (voiceIndex * 0.005f);
+        _driftLFOPhase = voiceIndex * 0.3f;
+        _warmupTime = 0.0f;
+        _warmupDrift = 1.0f;
+        _currentDetune = _staticDetune;
+    }
+
+    void setSampleRate(float sr) { _sampleRate = sr; }
+
+    void setAnalogCharacter(float amount) {
+        _characterAmount = std::clamp(amount, 0.0f, 2.0f);
+    }
+
+    float update() {
+        float detune = _staticDetune;
+        if (_warmupTime < 900.0f) {
+            float warmupProgress = _warmupTime / 900.0f;
+            _warmupDrift = 0.998f + (0.002f * warmupProgress);
+            _warmupTime += 1.0f / _sampleRate;
+        }
+
+        _driftLFOPhase += _driftLFOHz / _sampleRate;
+        if (_driftLFOPhase >= 1.0f) _driftLFOPhase -= 1.0f;
+        float driftLFO = fastmath::sin2pi(_driftLFOPhase);
+
+        float trackingError = 1.0f;
+        if (_baseFreq < 220.0f) {
+            trackingError = 0.999f + (0.002f * (220.0f - _baseFreq) / 220.0f);
+        }
+
+        _currentDetune = detune * _warmupDrift * trackingError *
+                         (1.0f + driftLFO * 0.0003f * _characterAmount);
+        _currentDetune = std::clamp(_currentDetune, 0.98f, 1.02f);
+        return _currentDetune;
+    }
+
+private:
+    float _baseFreq = 440.0f;
+    float _sampleRate = 44100.0f;
+    float _staticDetune = 1.0f;
+    float _currentDetune = 1.0f;
+    float _characterAmount = 1.0f;
+    float _driftLFOHz = 0.02f;
+    float _driftLFOPhase = 0.0f;
+    float _warmupTime = 0.0f;
+    float _warmupDrift = 1.0f;
+};
+
+
+// ============================================================
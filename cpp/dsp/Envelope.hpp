@@ -0,0 +1,108 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/ParameterScaler.hpp"
+
+class ExponentialADSR {
+public:
+    enum class Phase { Idle, Attack, Decay, Sustain, Release };
+
+    ExponentialADSR() { setSampleRate(_sampleRate); }
+
+    // Precomputes the coefficient of every slider position at this rate, so
+    // setTimes() from a patch (ParameterScaler curves) does no exp().
+    void setSampleRate(float sr) {
+        _sampleRate = sr;
+        for (std::size_t i = 0; i < _attackTable.size(); ++i) {
+            _attackTable[i]  = coefficient(Juno106::ParameterScaler::kAttackSeconds[i] * 0.5f);
+            _decayTable[i]   = coefficient(Juno106::ParameterScaler::kDecaySeconds[i] * 2.0f);
+            _releaseTable[i] = coefficient(Juno106::ParameterScaler::kDecaySeconds[i] * 3.0f);
+        }
+        updateCoefficients();
+    }
+
+    void setTimes(float a, float d, float s, float r) {
+        _attack = std::max(a, 0.001f);
+        _decay = std::max(d, 0.001f);
+        _sustain = std::clamp(s, 0.0f, 1.0f);
+        _release = std::max(r, 0.001f);
+        updateCoefficients();
+    }
+
+    void noteOn() {
+        _phase = Phase::Attack;
+    }
+
+    void noteOff() {
+        _phase = Phase::Release;
+    }
+
+    float process() {
+        switch (_phase) {
+            case Phase::Idle:
+                _level = 0.0f;
+                break;
+            case Phase::Attack:
+                _level += _attackCoeff * (1.0f - _level);
+                if (_level > 0.999f) { _level = 1.0f; _phase = Phase::Decay; }
+                break;
+            case Phase::Decay:
+                _level -= _decayCoeff * (_level - _sustain);
+                if (_level <= _sustain + 0.001f) { _level = _sustain; _phase = Phase::Sustain; }
+                break;
+            case Phase::Sustain:
+                break;
+            case Phase::Release:
+                _level -= _releaseCoeff * _level;
+                if (_level < 0.001f) { _level = 0.0f; _phase = Phase::Idle; }
+                break;
+            default:
+                break;
+        }
+        return _level;
+    }
+
+    // Writes `n` successive levels to `out`. Segments are one-pole
+    // recurrences on cached coefficients, so this is a multiply-add per
+    // sample; the stage only changes at a segment end.
+    void processBlock(float *out, int n) {
+        for (int i = 0; i < n; ++i) out[i] = process();
+    }
+
+    bool isActive() const { return _phase != Phase::Idle; }
+    float level() const { return _level; }
+
+private:
+    // Exact one-pole steps, so the segment times hold at the coarse step of
+    // a control-rate caller as well as per sample.
+    float coefficient(float timeConstant) const {
+        return 1.0f - std::exp(-1.0f / (_sampleRate * timeConstant));
+    }
+
+    // Table entry when `time` is a slider position of `curve`, else computed.
+    float lookup(const Juno106::CurveTable &curve, const Juno106::CurveTable &coeffs,
+                 float time, float scale) const {
+        const int i = Juno106::curveIndexOf(curve, time);
+        return i >= 0 ? coeffs[static_cast<std::size_t>(i)] : coefficient(time * scale);
+    }
+
+    void updateCoefficients() {
+        _attackCoeff  = lookup(Juno106::ParameterScaler::kAttackSeconds, _attackTable, _attack, 0.5f);
+        _decayCoeff   = lookup(Juno106::ParameterScaler::kDecaySeconds, _decayTable, _decay, 2.0f);
+        _releaseCoeff = lookup(Juno106::ParameterScaler::kDecaySeconds, _releaseTable, _release, 3.0f);
+    }
+
+    float _sampleRate = 44100.0f;
+    Phase _phase = Phase::Idle;
+    float _level = 0.0f;
+    float _attack = 0.01f, _decay = 0.2f, _sustain = 0.7f, _release = 0.4f;
+    float _attackCoeff = 0.0f, _decayCoeff = 0.0f, _releaseCoeff = 0.0f;
+    Juno106::CurveTable _attackTable{}, _decayTable{}, _releaseTable{};
+};
+
+
+// ============================================================
@@ -0,0 +1,100 @@
+// ============================================================
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Float approximations of the transcendentals on the per-sample paths.
+//
+// Every kernel is straight-line code (bit casts, a short polynomial and
+// selects whose arms are computed unconditionally, no libm calls, no
+// tables), so it inlines into the callers' loops and vectorises inside
+// fixed-width lane loops. Polynomials are minimax fits; the errors below
+// are the maxima measured over each function's domain by
+// tests/dsp/fast_math.cpp, in float arithmetic. Terms in |x| are the
+// rounding of the argument reduction or of a large result.
+//
+//   exp2(x)     relative 2.5e-7              x clamped to [-126, 127]
+//   exp(x)      relative 2.5e-7 + 1e-7 |x|
+//   log2(x)     absolute 2e-7 + 6e-8 |log2 x|  x clamped to >= FLT_MIN
+//   tanh(x)     absolute 2.5e-7              +-1 beyond |x| = 9
+//   sin2pi(t)   absolute 2.5e-7              sin(2 pi t), |t| < 2^22
+//   sin(x)      absolute 2.5e-7 + 1.2e-7 |x|
+namespace fastmath {
+
+inline float bitsToFloat(std::uint32_t bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline std::uint32_t floatToBits(float f) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+inline float clamp(float x, float lo, float hi) {
+    x = (x < lo) ? lo : x;
+    return (x > hi) ? hi : x;
+}
+
+inline float exp2(float x) {
+    x = clamp(x, -126.0f, 127.0f);
+    // Biased exponent of the nearest integer; x + 127.5 is positive, so
+    // truncation rounds.
+    const int biased = static_cast<int>(x + 127.5f);
+    const float f = x - static_cast<float>(biased - 127);   // [-0.5, 0.5]
+    const float p = 1.0f + f * (6.93146967e-01f + f * (2.40221197e-01f +
+                    f * (5.55071327e-02f + f * (9.67554133e-03f + f * 1.32764717e-03f))));
+    return p * bitsToFloat(static_cast<std::uint32_t>(biased) << 23);
+}
+
+inline float exp(float x) {
+    return exp2(x * 1.44269504f);
+}
+
+inline float log2(float x) {
+    x = (x < 1.17549435e-38f) ? 1.17549435e-38f : x;
+    const std::uint32_t bits = floatToBits(x);
+    float e = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+    float m = bitsToFloat((bits & 0x007fffffu) | 0x3f800000u);   // [1, 2)
+    // Centre the mantissa on 1: [sqrt(1/2), sqrt(2)).
+    const bool high = m > 1.41421356f;
+    const float mHalf = m * 0.5f;
+    const float eNext = e + 1.0f;
+    m = high ? mHalf : m;
+    e = high ? eNext : e;
+    const float s = (m - 1.0f) / (m + 1.0f);
+    const float s2 = s * s;
+    return e + s * (2.88539129f + s2 * (9.61470809e-01f + s2 * 5.98973879e-01f));
+}
+
+inline float tanh(float x) {
+    x = clamp(x, -9.0f, 9.0f);
+    const float t = exp2(x * 2.88539008f);   // e^(2x)
+    return (t - 1.0f) / (t + 1.0f);
+}
+
+// sin(2 pi t): t in turns, so oscillator phases need no scaling.
+inline float sin2pi(float t) {
+    const float whole = static_cast<float>(static_cast<int>(t + std::copysign(0.5f, t)));
+    float r = t - whole;                       // [-0.5, 0.5]
+    const float above = 0.5f - r;              // fold onto [-0.25, 0.25]
+    const float below = -0.5f - r;
+    r = (r > 0.25f) ? above : r;
+    r = (r < -0.25f) ? below : r;
+    const float r2 = r * r;
+    return r * (6.28318516f + r2 * (-4.13416550e+01f + r2 * (8.16010041e+01f +
+                r2 * (-7.65497827e+01f + r2 * 3.95367088e+01f))));
+}
+
+inline float sin(float x) {
+    return sin2pi(x * 0.159154943f);
+}
+
+} // namespace fastmath
+
+
+// ============================================================
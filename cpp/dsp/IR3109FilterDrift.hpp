@@ -0,0 +1,67 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/FastMath.hpp"
+
+class IR3109FilterDrift {
+public:
+    struct Params {
+        float cutoffHz = 1000.0f;
+        float resonance = 0.0f;   // 0..1
+        float temperature = 0.5f; // 0..1
+        float age = 0.3f;         // 0..1
+    };
+
+    void setSampleRate(float sr) { _sampleRate = sr; }
+
+    void setDriftAmount(float amount) {
+        _driftAmount = std::clamp(amount, 0.0f, 2.0f);
+    }
+
+    void reset() {
+        _driftState = 0.0f;
+        _driftLFOPhase = 0.0f;
+        _lastCutoff = 0.0f;
+    }
+
+    float process(const Params &params) {
+        float resonanceDrift = 0.0f;
+        if (params.resonance > 0.7f) {
+            // Q compensation
+            float qFactor = (params.resonance - 0.7f) / 0.3f;
+            resonanceDrift = -0.08f * qFactor * _driftAmount;
+        }
+
+        _driftLFOPhase += 0.1f / _sampleRate;
+        if (_driftLFOPhase >= 1.0f) _driftLFOPhase -= 1.0f;
+        float thermalDrift = fastmath::sin2pi(_driftLFOPhase) *
+                             0.005f * params.temperature * _driftAmount;
+
+        float targetCutoff = params.cutoffHz *
+                             (1.0f + resonanceDrift + thermalDrift) *
+                             (1.0f + params.age * 0.02f * _driftAmount);
+
+        float alpha = 1.0f - std::exp(-1.0f / (0.05f * _sampleRate));
+        _driftState += (targetCutoff - _driftState) * alpha;
+
+        float trackingError = 1.0f;
+        if (_driftState < 500.0f) trackingError = 0.995f;
+        _lastCutoff = _driftState * trackingError;
+
+        return std::clamp(_lastCutoff, 20.0f, 20000.0f);
+    }
+
+private:
+    float _sampleRate = 44100.0f;
+    float _driftAmount = 1.0f;
+    float _driftState = 0.0f;
+    float _driftLFOPhase = 0.0f;
+    float _lastCutoff = 0.0f;
+};
+
+
+// ============================================================
@@ -0,0 +1,88 @@
+// ============================================================
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "dsp/AnalogModelTier.hpp"
+
+class JFETVCA {
+public:
+    JFETVCA() {
+        _jfet1.Idss = 5.1e-3f;
+        _jfet1.Vp = -2.05f;
+        _jfet1.Rs = 100.0f;
+        _jfet2.Idss = 4.9e-3f;
+        _jfet2.Vp = -1.95f;
+        _jfet2.Rs = 100.0f;
+    }
+
+    void setSampleRate(float sr) { _sampleRate = sr; }
+
+    float process(float signal, float controlVoltage) {
+        return processBiased(signal, bias(controlVoltage));
+    }
+
+    // The JFET operating point depends only on the control voltage, so the
+    // signal-independent part of the output can be evaluated at control rate
+    // and interpolated; processBiased() then costs no pow() per sample.
+    // `Model` is an AnalogModelTier policy.
+    template <typename Model = UltraModel>
+    float bias(float controlVoltage) const {
+        float Vg = controlVoltage * -5.0f; // 0..1 -> 0..-5V-ish
+        return drainCurrent<Model>(_jfet1, Vg) * _jfet1.Rs -
+               drainCurrent<Model>(_jfet2, Vg) * _jfet2.Rs;
+    }
+
+    float processBiased(float signal, float bias) {
+        // Each JFET adds signal * 1 mS across Rs; the pair is differential.
+        float output = bias + signal * 0.001f * (_jfet1.Rs + _jfet2.Rs);
+
+        float Vthermal = 1e-6f * _sampleRate; // mild noise
+        output += _noise.next() * Vthermal;
+
+        if (output > 8.0f) output = 8.0f - 0.3f * (output - 8.0f);
+        if (output < -8.0f) output = -8.0f - 0.3f * (output + 8.0f);
+        return output * 0.125f;
+    }
+
+private:
+    struct JFET {
+        float Idss;
+        float Vp;
+        float Rs;
+    };
+
+    class Noise {
+    public:
+        float next() {
+            _state = _state * 1103515245u + 12345u;
+            return static_cast<float>(_state >> 16) / 65535.0f - 0.5f;
+        }
+    private:
+        uint32_t _state = 0x87654321u;
+    };
+
+    template <typename Model>
+    static float drainCurrent(const JFET &jfet, float Vg) {
+        float Vgs = Vg;
+        float Id = 0.0f;
+        for (int i = 0; i < Model::kJfetIterations; ++i) {
+            if (Vgs > jfet.Vp) {
+                Id = jfet.Idss * Model::square(1.0f - Vgs / jfet.Vp);
+            } else {
+                Id = 0.0f;
+            }
+            Vgs = Vg - Id * jfet.Rs;
+        }
+        return Id;
+    }
+
+    float _sampleRate = 44100.0f;
+    JFET _jfet1, _jfet2;
+    Noise _noise;
+};
+
+
+// ============================================================
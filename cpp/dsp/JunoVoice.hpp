@@ -0,0 +1,276 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "dsp/AnalogEnvelopeClick.hpp"
+#include "dsp/CableCapacitance.hpp"
+#include "dsp/DCOVoiceDetune.hpp"
+#include "dsp/Envelope.hpp"
+#include "dsp/FastMath.hpp"
+#include "dsp/IR3109FilterDrift.hpp"
+#include "dsp/IR3109OTA.hpp"
+#include "dsp/JFETVCA.hpp"
+#include "dsp/LFO.hpp"
+#include "dsp/Oversampler.hpp"
+#include "dsp/Oscillator.hpp"
+#include "dsp/ParameterScaler.hpp"
+#include "dsp/PowerSupplySag.hpp"
+
+struct VoiceParams {
+    float cutoffHz = 1000.0f;
+    float resonance = 0.2f;
+    float envToFilter = 0.5f;
+    float lfoToFilter = 0.2f;
+    float lfoRateHz = 4.0f;
+    float pwmDepth = 0.5f;
+    float subLevel = 0.0f;
+    float envAttack = 0.01f;
+    float envDecay = 0.2f;
+    float envSustain = 0.7f;
+    float envRelease = 0.4f;
+    float dcoBeating = 0.7f;
+    float filterDrift = 0.8f;
+    float envelopeClick = 0.6f;
+    float filterTemp = 0.5f;
+    float filterAge = 0.3f;
+};
+
+// Modulation runs on a control clock. Every `controlInterval` samples the
+// envelope, LFO, DCO drift and filter drift advance one tick (at sr /
+// interval) and the cutoff CV, VCA bias, pitch and PWM are recomputed; in
+// between they are interpolated linearly, so the per-sample loop is left
+// with the DCO, the click, the OTA stages and the VCA. An interval of 1
+// evaluates everything per sample.
+class JunoVoice {
+public:
+    // The 106's CPU refreshed envelopes, LFO and CVs on a few-millisecond
+    // timer; this is the tick the hardware mode approximates.
+    static constexpr float kFirmwareTickSeconds = 0.004f;
+
+    static int firmwareControlInterval(float sr) {
+        return std::max(1, static_cast<int>(std::lround(sr * kFirmwareTickSeconds)));
+    }
+
+    int getCurrentNote() const { return _currentNote; }
+
+    void init(int index, float sr) {
+        _index = index;
+        _sr = sr;
+        setOversampling(_oversampler.factor());
+        _dco.setSampleRate(sr);
+        _vca.setSampleRate(sr);
+        _click.setSampleRate(sr);
+        setControlInterval(_controlInterval);
+    }
+
+    // Samples per control tick; 1 = audio-rate modulation. Takes effect at
+    // the next tick.
+    void setControlInterval(int samples) {
+        _controlInterval = std::max(1, samples);
+        const float controlRate = _sr / static_cast<float>(_controlInterval);
+        _filterDrift.setSampleRate(controlRate);
+        _env.setSampleRate(controlRate);
+        _lfo.setSampleRate(controlRate);
+        _detune.setSampleRate(controlRate);
+    }
+
+    int controlInterval() const { return _controlInterval; }
+
+    // Runs the filter and VCA at 1, 2 or 4 times the sample rate behind an
+    // Oversampler; the DCO, click and modulation stay at the base rate.
+    void setOversampling(int factor) {
+        _oversampler.setFactor(factor);
+        _filter.setSampleRate(_sr * static_cast<float>(_oversampler.factor()));
+        _filter.setOversampling(_oversampler.factor());
+    }
+
+    int oversampling() const { return _oversampler.factor(); }
+
+    void setParams(const VoiceParams &p) { _params = p; }
+
+    // The 106 voice ignores velocity; its keyboard has none.
+    void noteOn(int midiNote, [[maybe_unused]] float velocity) {
+        _currentNote = midiNote;
+        float newFreq = midiToFreq(midiNote);
+        bool retrigger = _env.isActive();
+
+        _baseFreq = newFreq;
+        _detune.init(_baseFreq, _index, _sr / static_cast<float>(_controlInterval));
+        _detune.setAnalogCharacter(_params.dcoBeating);
+        _filterDrift.setDriftAmount(_params.filterDrift);
+        _click.setClickAmount(_params.envelopeClick);
+
+        if (retrigger) {
+            AnalogEnvelopeClick::ClickParams cp;
+            cp.isRetrigger = true;
+            cp.releaseLevel = _env.level();
+            cp.attackTime = _params.envAttack;
+            cp.sampleRate = _sr;
+            _click.triggerClick(cp);
+        }
+
+        _env.setTimes(_params.envAttack, _params.envDecay,
+                      _params.envSustain, _params.envRelease);
+        _env.noteOn();
+        _lfo.trigger();
+        _active = true;
+        _age = 0.0;
+        // Restart the control clock so the attack starts on this sample, and
+        // jump the CVs to the new note instead of gliding from the old one.
+        _controlPhase = 0;
+        _controlPrimed = false;
+    }
+
+    void noteOff() {
+        _env.noteOff();
+    }
+
+    bool isActive() const { return _env.isActive(); }
+    float envelopeLevel() const { return _env.level(); }
+
+    void setAftertouch(float pressure) { _aftertouch = pressure; }
+
+    // `Model` picks the filter/VCA quality tier (see AnalogModelTier);
+    // callers choose it once per block, and the state carries across tiers.
+    template <typename Model = UltraModel>
+    float processSample() {
+        if (!_active && !_env.isActive()) {
+            return 0.0f;
+        }
+        _age += 1.0 / _sr;
+
+        if (_controlPhase == 0) {
+            updateControl<Model>();
+        }
+        if (++_controlPhase == _controlInterval) {
+            _controlPhase = 0;
+        }
+
+        float click = _click.process();
+
+        float freq = _baseFreq * _pitch.next();
+        float osc = _dco.process(freq, _lfoValue.next(), _params.pwmDepth, true, _params.subLevel);
+        osc += click * 0.7f;
+
+        float resCV = std::clamp(_params.resonance, 0.0f, 1.0f);
+        const float tailCurrent = _tailCurrent.next();
+        const float vcaBias = _vcaBias.next();
+        float vcaOut = 0.0f;
+        if (_oversampler.factor() == 1) {
+            float filtered = _filter.processCurrent<Model>(osc, tailCurrent, resCV, _params.filterTemp);
+            vcaOut = _vca.processBiased(filtered, vcaBias);
+        } else {
+            float up[Oversampler<1>::kMaxFactor];
+            _oversampler.upsample(&osc, up);
+            for (int k = 0; k < _oversampler.factor(); ++k) {
+                float filtered = _filter.processCurrent<Model>(up[k], tailCurrent, resCV, _params.filterTemp);
+                up[k] = _vca.processBiased(filtered, vcaBias);
+            }
+            _oversampler.downsample(up, &vcaOut);
+        }
+
+        if (!_env.isActive()) {
+            _active = false;
+        }
+
+        return vcaOut;
+    }
+
+    double age() const { return _age; }
+
+private:
+    // A control value moving linearly to its next target over one tick. The
+    // last sample of the tick lands exactly on the target.
+    struct ControlRamp {
+        float value = 0.0f;
+        float target = 0.0f;
+        float step = 0.0f;
+        int remaining = 0;
+
+        void setTarget(float t, int samples) {
+            target = t;
+            step = (t - value) / static_cast<float>(samples);
+            remaining = samples;
+        }
+
+        float next() {
+            value = (--remaining <= 0) ? target : value + step;
+            return value;
+        }
+    };
+
+    // One control tick: advance the modulation sources and recompute the CVs
+    // the audio path interpolates towards.
+    template <typename Model>
+    void updateControl() {
+        float envVal = _env.process();
+        float lfoVal = _lfo.process();
+        float det = _detune.update();
+
+        // Compute cutoff with mods + drift
+        float cutoffNorm = std::clamp(fastmath::log2(_params.cutoffHz) * 0.0752574989f, 0.0f, 1.0f);
+        float envMod = envVal * _params.envToFilter;
+        float lfoMod = lfoVal * _params.lfoToFilter;
+        float atMod = _aftertouch * 0.5f;
+        float cutoffMod = cutoffNorm + envMod + lfoMod + atMod;
+        cutoffMod = std::clamp(cutoffMod, 0.0f, 1.0f);
+
+        float cutoffHz = 20.0f * fastmath::exp2(cutoffMod * 9.96578428f);
+        IR3109FilterDrift::Params dp;
+        dp.cutoffHz = cutoffHz;
+        dp.resonance = _params.resonance;
+        dp.temperature = _params.filterTemp;
+        dp.age = _params.filterAge;
+
+        float driftedCutoff = _filterDrift.process(dp);
+
+        float cutoffCV = fastmath::log2(std::max(20.0f, driftedCutoff)) * 0.1f;
+
+        const int ramp = _controlPrimed ? _controlInterval : 1;
+        _controlPrimed = true;
+        _pitch.setTarget(det, ramp);
+        _lfoValue.setTarget(lfoVal, ramp);
+        _tailCurrent.setTarget(_filter.tailCurrent<Model>(cutoffCV, _params.filterTemp), ramp);
+        _vcaBias.setTarget(_vca.bias<Model>(envVal), ramp);
+    }
+
+    float midiToFreq(int note) {
+        return Juno106::ParameterScaler::noteToHz(note);
+    }
+
+    int _index = 0;
+    int _currentNote = -1;
+    float _sr = 44100.0f;
+    bool _active = false;
+    double _age = 0.0;
+
+    float _baseFreq = 440.0f;
+    float _aftertouch = 0.0f;
+
+    int _controlInterval = 1;
+    int _controlPhase = 0;
+    bool _controlPrimed = false;
+    ControlRamp _pitch;        // detune multiplier
+    ControlRamp _lfoValue;
+    ControlRamp _tailCurrent;  // OTA I_abc for the cutoff CV
+    ControlRamp _vcaBias;      // JFETVCA::bias() of the envelope
+
+    VoiceParams _params;
+    IR3109Filter _filter;
+    IR3109FilterDrift _filterDrift;
+    DCOVoiceDetune _detune;
+    AnalogEnvelopeClick _click;
+    ExponentialADSR _env;
+    DCO _dco;
+    JunoLFO _lfo;
+    JFETVCA _vca;
+    Oversampler<1> _oversampler;
+};
+
+
+// ============================================================
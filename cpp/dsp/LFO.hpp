@@ -0,0 +1,34 @@
+// ============================================================
+
+#pragma once
+
+class JunoLFO {
+public:
+    void setSampleRate(float sr) { _sampleRate = sr; }
+    void setRate(float hz) { _rate = hz; }
+    void trigger() { _noteTriggered = true; }
+
+    float process() {
+        if (_noteTriggered) {
+            _phase = 0.0f;
+            _noteTriggered = false;
+        }
+        float inc = _rate / _sampleRate;
+        _phase += inc;
+        if (_phase >= 1.0f) _phase -= 1.0f;
+
+        // Slightly curved triangle for hardware-ish behavior
+        if (_phase < 0.25f) return 4.0f * _phase;
+        if (_phase < 0.75f) return 2.0f - 4.0f * _phase;
+        return 4.0f * _phase - 4.0f;
+    }
+
+private:
+    float _sampleRate = 44100.0f;
+    float _rate = 1.0f;
+    float _phase = 0.0f;
+    bool _noteTriggered = false;
+};
+
+
+// ============================================================
@@ -0,0 +1,44 @@
+// ============================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/PolyBLEP.hpp"
+
+// Saw + pulse DCO with a square sub an octave down. Every edge is
+// band-limited by PolyBLEP, so high notes stay free of audible aliasing
+// without oversampling the oscillator.
+class DCO {
+public:
+    void setSampleRate(float sr) { _sampleRate = sr; }
+
+    float process(float freqHz, float lfoValue, float pwmDepth, bool usePWM,
+                  float subLevel = 0.0f) {
+        float phaseInc = freqHz / _sampleRate;
+        float subInc = phaseInc * 0.5f;
+        float invInc = polyblep::inverseIncrement(phaseInc);
+        _phase += phaseInc;
+        if (_phase >= 1.0f) _phase -= 1.0f;
+        _subPhase += subInc;
+        if (_subPhase >= 1.0f) _subPhase -= 1.0f;
+
+        float duty = 0.5f;
+        if (usePWM) {
+            duty = 0.5f + pwmDepth * 0.49f * lfoValue;
+            duty = std::clamp(duty, 0.05f, 0.95f);
+        }
+        // Mix saw + square like Juno
+        float osc = polyblep::sawPulse(_phase, duty, phaseInc, invInc);
+        float sub = polyblep::sub(_subPhase, subInc, polyblep::inverseIncrement(subInc));
+        return (osc + sub * subLevel) * 0.7f;
+    }
+
+private:
+    float _sampleRate = 44100.0f;
+    float _phase = 0.0f;
+    float _subPhase = 0.0f;
+};
+
+// ============================================================
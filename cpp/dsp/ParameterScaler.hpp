@@ -2,17 +2,103 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cmath>
 
 namespace Juno106 {
 
+// Every slider and key is a 7-bit value, so each curve is a 128-entry
+// table generated at compile time; patch loads and note-ons index them
+// instead of calling log/exp/pow.
+using CurveTable = std::array<float, 128>;
+
+namespace detail {
+
+// constexpr exp/log for the table generators (double, ~1e-15 relative
+// over the ranges used here).
+constexpr double exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x *= 0.5;
+        ++halvings;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings-- > 0) sum *= sum;
+    return sum;
+}
+
+constexpr double log(double x) {
+    constexpr double kLn2 = 0.69314718055994530942;
+    int exponent = 0;
+    while (x > 1.5) {
+        x *= 0.5;
+        ++exponent;
+    }
+    while (x < 0.75) {
+        x *= 2.0;
+        --exponent;
+    }
+    const double s = (x - 1.0) / (x + 1.0);
+    double term = s;
+    double sum = 0.0;
+    for (int n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= s * s;
+    }
+    return 2.0 * sum + exponent * kLn2;
+}
+
+} // namespace detail
+
+// lo at 0 to hi at 127, exponential in between.
+constexpr CurveTable exponentialCurve(double lo, double hi) {
+    CurveTable table{};
+    const double span = detail::log(hi / lo);
+    for (int i = 0; i < 128; ++i) {
+        table[static_cast<std::size_t>(i)] = static_cast<float>(lo * detail::exp(span * i / 127.0));
+    }
+    return table;
+}
+
+// Equal-tempered MIDI note frequencies, A4 (69) = 440 Hz.
+constexpr CurveTable noteFrequencyTable() {
+    CurveTable table{};
+    for (int i = 0; i < 128; ++i) {
+        table[static_cast<std::size_t>(i)] =
+            static_cast<float>(440.0 * detail::exp((i - 69) / 12.0 * 0.69314718055994530942));
+    }
+    return table;
+}
+
+// Index of `value` in an increasing `table`, or -1 if it is not an entry;
+// lets per-sample-rate tables keyed on a curve recognise its values.
+inline int curveIndexOf(const CurveTable &table, float value) {
+    const auto it = std::lower_bound(table.begin(), table.end(), value);
+    return (it != table.end() && *it == value) ? static_cast<int>(it - table.begin()) : -1;
+}
+
 class ParameterScaler {
 public:
+    static constexpr CurveTable kCutoffHz      = exponentialCurve(50.0, 15000.0);
+    static constexpr CurveTable kAttackSeconds = exponentialCurve(0.0015, 3.0);
+    static constexpr CurveTable kDecaySeconds  = exponentialCurve(0.0015, 12.0);
+    static constexpr CurveTable kLfoHz         = exponentialCurve(0.5, 30.0);
+    static constexpr CurveTable kNoteHz        = noteFrequencyTable();
+
     // JUNO‑style cutoff: 50 Hz → ~15 kHz with a log curve.
-    static float vcfCutoffToHz(uint8_t midiValue,
-                               float minFreq = 50.0f,
-                               float maxFreq = 15000.0f) {
+    static float vcfCutoffToHz(uint8_t midiValue) {
+        return kCutoffHz[index(midiValue)];
+    }
+
+    // As above over a custom range; computed, not tabulated.
+    static float vcfCutoffToHz(uint8_t midiValue, float minFreq, float maxFreq) {
         const float t = static_cast<float>(midiValue) / 127.0f;
         const float logMin = std::log(minFreq);
         const float logMax = std::log(maxFreq);
@@ -24,28 +110,25 @@ public:
     // Attack: 1.5 ms → 3 s
     // Decay/Release: 1.5 ms → 12 s
     static float envelopeTimeToSeconds(uint8_t midiValue, bool isAttack = false) {
-        const float t = static_cast<float>(midiValue) / 127.0f;
-        const float minT = 0.0015f;
-        const float maxT = isAttack ? 3.0f : 12.0f;
-        const float logMin = std::log(minT);
-        const float logMax = std::log(maxT);
-        const float logV = logMin + (logMax - logMin) * t;
-        return std::exp(logV);
+        return (isAttack ? kAttackSeconds : kDecaySeconds)[index(midiValue)];
     }
 
     // LFO rate: about 0.5–30 Hz with a tilted exponential curve.
     static float lfoRateToHz(uint8_t midiValue) {
-        const float t = static_cast<float>(midiValue) / 127.0f;
-        const float minHz = 0.5f;
-        const float maxHz = 30.0f;
-        const float logMin = std::log(minHz);
-        const float logMax = std::log(maxHz);
-        const float logV = logMin + (logMax - logMin) * t;
-        return std::exp(logV);
+        return kLfoHz[index(midiValue)];
+    }
+
+    // MIDI note to Hz; notes outside 0..127 are clamped.
+    static float noteToHz(int note) {
+        return kNoteHz[static_cast<std::size_t>(std::clamp(note, 0, 127))];
+    }
+
+private:
+    static std::size_t index(uint8_t midiValue) {
+        return static_cast<std::size_t>(std::min<int>(midiValue, 127));
     }
 };
 
 } // namespace Juno106
 
-
 // ============================================================
@@ -0,0 +1,64 @@
+// ============================================================
+
+#pragma once
+
+// Band-limited DCO waveforms by PolyBLEP.
+//
+// Each discontinuity of a naive waveform is smoothed by a two-sample
+// polynomial residual (band-limited step minus ideal step), which removes
+// most of the aliasing at the cost of a few multiplies and no tables. The
+// functions are branch-free selects on plain floats, so they vectorise when
+// called from a fixed-width lane loop (see VoiceBank) and stay cheap enough
+// to run every voice at the base rate.
+//
+// `p` is the phase in [0, 1), `dt` the phase increment per sample and
+// `invDt` its reciprocal (0 for a stopped oscillator).
+namespace polyblep {
+
+// Residual for a unit upward step at phase 0, non-zero only within one
+// sample either side of it.
+inline float residual(float t, float dt, float invDt) {
+    const float a = t * invDt;              // just after the step
+    const float b = (t - 1.0f) * invDt;     // just before the wrap
+    const float after = a + a - a * a - 1.0f;
+    const float before = b * b + b + b + 1.0f;
+    return (t < dt) ? after : ((t > 1.0f - dt) ? before : 0.0f);
+}
+
+inline float wrap(float t) {
+    return (t >= 1.0f) ? t - 1.0f : ((t < 0.0f) ? t + 1.0f : t);
+}
+
+// Rising saw, -1..1, falling edge at phase 0.
+inline float saw(float p, float dt, float invDt) {
+    return 2.0f * p - 1.0f - residual(p, dt, invDt);
+}
+
+// +1 while p < width, -1 after; rising edge at 0, falling edge at width.
+inline float pulse(float p, float width, float dt, float invDt) {
+    const float naive = (p < width) ? 1.0f : -1.0f;
+    return naive + residual(p, dt, invDt) - residual(wrap(p - width + 1.0f), dt, invDt);
+}
+
+// The DCO's main output: saw and PWM pulse mixed 60/40, within -1..1.
+// An equal mix would cancel the saw's edge against the pulse's rising one
+// and leave the width as a mere phase shift.
+inline float sawPulse(float p, float width, float dt, float invDt) {
+    return 0.6f * saw(p, dt, invDt) + 0.4f * pulse(p, width, dt, invDt);
+}
+
+// Square sub oscillator; `p`, `dt` and `invDt` are the sub's own (half
+// the main frequency).
+inline float sub(float p, float dt, float invDt) {
+    return pulse(p, 0.5f, dt, invDt);
+}
+
+// 1 / dt, or 0 for a stopped oscillator so residual() stays finite.
+inline float inverseIncrement(float dt) {
+    return (dt > 0.0f) ? 1.0f / dt : 0.0f;
+}
+
+} // namespace polyblep
+
+
+// ============================================================
@@ -0,0 +1,91 @@
+// ============================================================
+
+#pragma once
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define JUNO_DENORMAL_GUARD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JUNO_DENORMAL_GUARD_ARM64 1
+#elif defined(__arm__) && defined(__ARM_FP)
+#define JUNO_DENORMAL_GUARD_ARM32 1
+#endif
+
+// Scoped flush-to-zero for the calling thread.
+//
+// Decaying filter states, integrators and delay lines eventually drift into
+// the denormal range, where every operation on x86 takes a microcode assist
+// and a release tail can cost many times the CPU of a held note. While a
+// guard is alive denormal results are flushed to zero (x86 MXCSR FTZ, ARM
+// FPCR/FPSCR FZ) and denormal inputs read as zero (x86 DAZ; ARM FZ covers
+// both). The previous mode is restored on destruction, so a guard on render
+// entry never leaks into the host's thread. Elsewhere it is a no-op.
+class DenormalGuard {
+public:
+    explicit DenormalGuard(bool enabled = true) noexcept
+        : saved_(read()), enabled_(enabled) {
+        if (enabled_) write(saved_ | kFlushBits);
+    }
+
+    ~DenormalGuard() {
+        if (enabled_) write(saved_);
+    }
+
+    DenormalGuard(const DenormalGuard &) = delete;
+    DenormalGuard &operator=(const DenormalGuard &) = delete;
+
+    // True if this target has a flush-to-zero mode the guard can set.
+    static constexpr bool supported() { return kFlushBits != 0; }
+
+    // True if the calling thread currently flushes denormals.
+    static bool active() noexcept { return supported() && (read() & kFlushBits) == kFlushBits; }
+
+private:
+#if defined(JUNO_DENORMAL_GUARD_X86)
+    static constexpr std::uint64_t kFlushBits = 0x8040;      // FTZ (bit 15) | DAZ (bit 6)
+#elif defined(JUNO_DENORMAL_GUARD_ARM64) || defined(JUNO_DENORMAL_GUARD_ARM32)
+    static constexpr std::uint64_t kFlushBits = 1u << 24;    // FZ
+#else
+    static constexpr std::uint64_t kFlushBits = 0;
+#endif
+
+    static std::uint64_t read() noexcept {
+#if defined(JUNO_DENORMAL_GUARD_X86)
+        return _mm_getcsr();
+#elif defined(JUNO_DENORMAL_GUARD_ARM64) && defined(_MSC_VER)
+        return _ReadStatusReg(ARM64_FPCR);
+#elif defined(JUNO_DENORMAL_GUARD_ARM64)
+        std::uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        return fpcr;
+#elif defined(JUNO_DENORMAL_GUARD_ARM32)
+        std::uint32_t fpscr;
+        __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+        return fpscr;
+#else
+        return 0;
+#endif
+    }
+
+    static void write(std::uint64_t mode) noexcept {
+#if defined(JUNO_DENORMAL_GUARD_X86)
+        _mm_setcsr(static_cast<unsigned int>(mode));
+#elif defined(JUNO_DENORMAL_GUARD_ARM64) && defined(_MSC_VER)
+        _WriteStatusReg(ARM64_FPCR, static_cast<__int64>(mode));
+#elif defined(JUNO_DENORMAL_GUARD_ARM64)
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(mode));
+#elif defined(JUNO_DENORMAL_GUARD_ARM32)
+        const std::uint32_t fpscr = static_cast<std::uint32_t>(mode);
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr));
+#else
+        (void)mode;
+#endif
+    }
+
+    std::uint64_t saved_;
+    bool enabled_;
+};
+
+
+// ============================================================
@@ -14,6 +14,7 @@
 //       float lfoToFilter;
 //       float lfoRateHz;
 //       float pwmDepth;
+//       float subLevel;
 //       float envAttack;
 //       float envDecay;
 //       float envSustain;
@@ -41,11 +42,23 @@
 //   class BBDClockNoise { ... };
 //   class PowerSupplySag { ... };
 //   class CableCapacitance { ... };
+//
+// Threading: the setters, note calls and loadJuno106Sysex() may be called
+// from any thread while render() runs. None of them touch render state:
+// parameters are published as one triple-buffered Snapshot and notes go
+// through a lock-free queue, both picked up by render() at block start.
+// init() is setup-only and must not race with render().
+//
+// Idle: once no voice is sounding and the chorus/cable tail has played out,
+// render() zero-fills and returns true without running the bus. The BBD
+// clock hiss is gated with it, as a noise gate on the output would.
 
 #pragma once
 
+#include <algorithm>
 #include <array>
-#include <mutex>
+#include <atomic>
+#include <vector>
 
 // These includes refer to your existing files:
 #include "dsp/BBDClockNoise.hpp"
@@ -54,35 +67,52 @@
 #include "dsp/BBDChorus.hpp"
 #include "parser/Juno106PatchParser.hpp"
 #include "dsp/ParameterScaler.hpp"
+#include "dsp/AnalogModelTier.hpp"
 #include "dsp/JunoVoice.hpp"
+#include "engine/DenormalGuard.hpp"
+#include "engine/NoteEventQueue.hpp"
+#include "engine/VoiceAllocator.hpp"
+#include "engine/TripleBuffer.hpp"
 
 class JunoEngine {
 public:
     static constexpr int VOICE_COUNT = 6;
 
+    // Everything the control side can change, published as one unit so the
+    // render thread never sees half of an update.
+    struct Snapshot {
+        VoiceParams voice;
+        float cableLength = 3.0f;
+        int chorusMode = 0;       // 0 = Off, 1 = Chorus I, 2 = Chorus II
+        uint8_t hpfStep = 0;
+        int controlInterval = 1;  // samples per modulation tick, 1 = audio rate
+        bool flushDenormals = true;
+        VoiceAllocator::Policy voicePolicy = VoiceAllocator::Policy::Quietest;
+        AnalogTier tier = AnalogTier::Standard;
+        int oversampling = 1;     // filter/VCA rate multiple: 1, 2 or 4
+    };
+
     void init(double sr) {
-        std::lock_guard<std::mutex> g(_mtx);
         _sr = static_cast<float>(sr);
         for (int i = 0; i < VOICE_COUNT; ++i) {
             _voices[i].init(i, _sr);
-            _voiceParams[i] = _defaultVoiceParams;
-            _voices[i].setParams(_voiceParams[i]);
         }
+        _allocator.initialize(VOICE_COUNT);
         _bbdNoise.setSampleRate(_sr);
         _bbdNoise.setClockRate(15000.0f);
         _powerSag.setSampleRate(_sr);
-        _cableSim.setCableLength(3.0f, _sr);
         _chorus.setSampleRate(_sr);
-        _chorus.setMode(BBDChorus::Mode::Off);
+        _tailFrames = _chorus.tailFrames();
+        // Nothing has played yet, so there is no tail either.
+        _quietFrames = _tailFrames;
+
+        _snapshot.acquire();
+        _cableLength = -1.0f;
+        applySnapshot(_snapshot.read());
     }
 
     void setVoiceParams(const VoiceParams& p) {
-        std::lock_guard<std::mutex> g(_mtx);
-        _defaultVoiceParams = p;
-        for (int i = 0; i < VOICE_COUNT; ++i) {
-            _voiceParams[i] = p;
-            _voices[i].setParams(_voiceParams[i]);
-        }
+        _snapshot.update([&](Snapshot& s) { s.voice = p; });
     }
 
     void setAnalogCharacter(float dcoBeating,
@@ -91,27 +121,59 @@ public:
                             float cableLength,
                             float temperature,
                             float age) {
-        std::lock_guard<std::mutex> g(_mtx);
-        _defaultVoiceParams.dcoBeating    = dcoBeating;
-        _defaultVoiceParams.filterDrift   = filterDrift;
-        _defaultVoiceParams.envelopeClick = envClick;
-        _defaultVoiceParams.filterTemp    = temperature;
-        _defaultVoiceParams.filterAge     = age;
-        _cableSim.setCableLength(cableLength, _sr);
-        for (int i = 0; i < VOICE_COUNT; ++i) {
-            _voiceParams[i] = _defaultVoiceParams;
-            _voices[i].setParams(_voiceParams[i]);
-        }
+        _snapshot.update([&](Snapshot& s) {
+            s.voice.dcoBeating    = dcoBeating;
+            s.voice.filterDrift   = filterDrift;
+            s.voice.envelopeClick = envClick;
+            s.voice.filterTemp    = temperature;
+            s.voice.filterAge     = age;
+            s.cableLength         = cableLength;
+        });
+    }
+
+    // Evaluate envelopes, LFO, drift and cutoff CV every `samples` samples
+    // and interpolate in between (see JunoVoice). 1 = every sample.
+    void setControlInterval(int samples) {
+        _snapshot.update([&](Snapshot& s) { s.controlInterval = std::max(1, samples); });
+    }
+
+    // Control rate at the hardware's firmware tick. Call after init().
+    void setFirmwareControlRate() {
+        setControlInterval(JunoVoice::firmwareControlInterval(_sr));
+    }
+
+    // How notes are assigned and which voice is stolen when all six are busy.
+    void setVoicePolicy(VoiceAllocator::Policy policy) {
+        _snapshot.update([&](Snapshot& s) { s.voicePolicy = policy; });
+    }
+
+    // Quality tier of the filter and VCA models (see AnalogModelTier);
+    // Standard by default, Ultra for libm-exact reference renders.
+    // Switches between blocks without a discontinuity.
+    void setAnalogTier(AnalogTier tier) {
+        _snapshot.update([&](Snapshot& s) { s.tier = tier; });
+    }
+
+    // Runs every voice's filter and VCA at 1, 2 or 4 times the sample rate
+    // so their saturation does not alias. Adds oversamplingLatency(factor)
+    // frames of delay; changing it clears the oversampler history.
+    void setOversampling(int factor) {
+        _snapshot.update([&](Snapshot& s) { s.oversampling = factor; });
+    }
+
+    static float oversamplingLatency(int factor) {
+        return Oversampler<1>::latencyFor(factor);
+    }
+
+    // render() runs under a DenormalGuard (FTZ/DAZ) unless this is turned
+    // off, which only makes sense for benchmarking.
+    void setFlushDenormals(bool enabled) {
+        _snapshot.update([&](Snapshot& s) { s.flushDenormals = enabled; });
     }
 
     // 0 = Off, 1 = Chorus I, 2 = Chorus II
     void setChorusMode(int mode) {
-        std::lock_guard<std::mutex> g(_mtx);
-        switch (mode) {
-            case 1: _chorus.setMode(BBDChorus::Mode::I);  break;
-            case 2: _chorus.setMode(BBDChorus::Mode::II); break;
-            default: _chorus.setMode(BBDChorus::Mode::Off); break;
-        }
+        _snapshot.update([&](Snapshot& s) { s.chorusMode = mode; });
     }
 
     // Load a single Juno‑106 patch from raw sysex and apply it to the global voice params.
@@ -130,32 +192,108 @@ public:
         return true;
     }
 
+    // Notes are dropped if the queue is full (more than
+    // NoteEventQueue::kCapacity pending between two render() calls).
     void noteOn(int midiNote, float velocity) {
-        std::lock_guard<std::mutex> g(_mtx);
-        _currentNote = midiNote;
-        int voiceIdx = findVoiceToSteal();
-        _voices[voiceIdx].setParams(_voiceParams[voiceIdx]);
-        _voices[voiceIdx].noteOn(midiNote, velocity);
+        _currentNote.store(midiNote, std::memory_order_relaxed);
+        _notes.push({NoteEvent::Type::NoteOn, midiNote, velocity});
     }
 
     void noteOff(int midiNote) {
-        std::lock_guard<std::mutex> g(_mtx);
-        for (int i = 0; i < VOICE_COUNT; ++i) {
-            if (_voices[i].getCurrentNote() == midiNote) {
-                _voices[i].noteOff();
-            }
-        }
+        _notes.push({NoteEvent::Type::NoteOff, midiNote, 0.0f});
     }
 
     void setPolyAftertouch(int voiceIndex, float pressure) {
         if (voiceIndex < 0 || voiceIndex >= VOICE_COUNT) return;
-        std::lock_guard<std::mutex> g(_mtx);
-        _voices[voiceIndex].setAftertouch(pressure);
+        _notes.push({NoteEvent::Type::Aftertouch, voiceIndex, pressure});
     }
 
-    void render(float* outL, float* outR, int frames) {
-        std::lock_guard<std::mutex> g(_mtx);
+    // Returns true if the block is silent (both outputs zero-filled).
+    bool render(float* outL, float* outR, int frames) {
+        // Wait-free: one atomic exchange if parameters changed, then
+        // whatever notes are queued.
+        if (_snapshot.acquire()) {
+            applySnapshot(_snapshot.read());
+        }
+        applyNoteEvents();
+
+        const DenormalGuard denormals(_flushDenormals);
+
+        if (!anyVoiceActive() && _quietFrames >= _tailFrames) {
+            std::fill(outL, outL + frames, 0.0f);
+            std::fill(outR, outR + frames, 0.0f);
+            _quietFrames += frames;
+            return true;
+        }
+
+        const bool voiced = withAnalogTier(_tier, [&](auto model) {
+            return renderVoices<decltype(model)>(outL, outR, frames);
+        });
 
+        _allocator.reclaim([this](int v) { return _voices[v].isActive(); });
+        _quietFrames = voiced ? 0 : _quietFrames + frames;
+        return false;
+    }
+
+private:
+    void applySnapshot(const Snapshot& s) {
+        for (int i = 0; i < VOICE_COUNT; ++i) {
+            _voiceParams[i] = s.voice;
+            _voices[i].setParams(_voiceParams[i]);
+        }
+        if (s.controlInterval != _voices[0].controlInterval()) {
+            for (auto& v : _voices) v.setControlInterval(s.controlInterval);
+        }
+        if (s.oversampling != _oversampling) {
+            _oversampling = s.oversampling;
+            for (auto& v : _voices) v.setOversampling(_oversampling);
+        }
+        if (s.cableLength != _cableLength) {
+            _cableLength = s.cableLength;
+            _cableSim.setCableLength(_cableLength, _sr);
+        }
+        switch (s.chorusMode) {
+            case 1: _chorus.setMode(BBDChorus::Mode::I);  break;
+            case 2: _chorus.setMode(BBDChorus::Mode::II); break;
+            default: _chorus.setMode(BBDChorus::Mode::Off); break;
+        }
+        // HPF steps: 0=off, 1=~80 Hz, 2=~160 Hz, 3=~360 Hz.
+        _currentHPFStep = s.hpfStep;
+        _flushDenormals = s.flushDenormals;
+        _allocator.setPolicy(s.voicePolicy);
+        _tier = s.tier;
+    }
+
+    void applyNoteEvents() {
+        NoteEvent e;
+        while (_notes.pop(e)) {
+            switch (e.type) {
+                case NoteEvent::Type::NoteOn: {
+                    const int voiceIdx = _allocator.noteOn(e.note, [this](int v) {
+                        return _voices[v].envelopeLevel();
+                    });
+                    if (voiceIdx < 0) break;
+                    _voices[voiceIdx].setParams(_voiceParams[voiceIdx]);
+                    _voices[voiceIdx].noteOn(e.note, e.value);
+                    break;
+                }
+                case NoteEvent::Type::NoteOff: {
+                    const int voiceIdx = _allocator.noteOff(e.note);
+                    if (voiceIdx >= 0) _voices[voiceIdx].noteOff();
+                    break;
+                }
+                case NoteEvent::Type::Aftertouch:
+                    _voices[e.note].setAftertouch(e.value);
+                    break;
+            }
+        }
+    }
+
+    // The voice loop and bus for one block, with the analog models at the
+    // `Model` tier. Returns true if any voice sounded.
+    template <typename Model>
+    bool renderVoices(float* outL, float* outR, int frames) {
+        bool voiced = false;
         for (int f = 0; f < frames; ++f) {
             float mix = 0.0f;
             int activeVoices = 0;
@@ -169,9 +307,10 @@ public:
             }
 
             _powerSag.update(activeVoices, totalRes);
+            voiced |= activeVoices > 0;
 
             for (int i = 0; i < VOICE_COUNT; ++i) {
-                float s = _voices[i].processSample();
+                float s = _voices[i].processSample<Model>();
                 mix += s;
             }
 
@@ -193,96 +332,79 @@ public:
             outL[f] = l * 0.7f;
             outR[f] = r * 0.7f;
         }
+        return voiced;
     }
 
-private:
-    int findVoiceToSteal() const {
-        int idx = 0;
-        float minLevel = 1e9f;
-        for (int i = 0; i < VOICE_COUNT; ++i) {
-            float lvl = _voices[i].envelopeLevel();
-            if (lvl < minLevel) {
-                minLevel = lvl;
-                idx = i;
-            }
+    bool anyVoiceActive() const {
+        for (const auto& v : _voices) {
+            if (v.isActive()) return true;
         }
-        return idx;
+        return false;
     }
 
-    void applyPatch(const Juno106::JunoPatch& p) {
-        VoiceParams vp = _defaultVoiceParams;
-
-        // Map VCF
-        vp.cutoffHz   = Juno106::ParameterScaler::vcfCutoffToHz(p.vcfCutoff);
-        vp.resonance  = static_cast<float>(p.vcfResonance) / 127.0f;
-
-        // Envelope to filter amount (centered around 0.5 so negative values
-        // can be used when vcfEnvPositive is false)
-        const float envAmount = static_cast<float>(p.vcfEnvMod) / 127.0f;
-        vp.envToFilter = p.switches.vcfEnvPositive ? envAmount : -envAmount;
-
-        // LFO to filter
-        vp.lfoToFilter = static_cast<float>(p.vcfLfoMod) / 127.0f;
-        vp.lfoRateHz   = Juno106::ParameterScaler::lfoRateToHz(p.lfoRate);
-
-        // PWM depth: map 0‑127 to something musically useful (0–1 range)
-        vp.pwmDepth = static_cast<float>(p.dcoPwmDepth) / 127.0f;
-
-        // Envelope times
-        vp.envAttack  = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envAttack, true);
-        vp.envDecay   = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envDecay, false);
-        vp.envRelease = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envRelease, false);
-        vp.envSustain = static_cast<float>(p.envSustain) / 127.0f;
-
-        // Simple mapping for analog character / drift; these can later be
-        // refined to depend on patch age, chorus usage, etc.
-        vp.dcoBeating    = 0.5f + 0.5f * (static_cast<float>(p.dcoLfoMod) / 127.0f);
-        vp.filterDrift   = 0.5f;
-        vp.envelopeClick = 0.5f;
-        vp.filterTemp    = 0.5f;
-        vp.filterAge     = 0.3f;
-
-        // HPF steps: 0=off, 1=~80 Hz, 2=~160 Hz, 3=~360 Hz.
-        _currentHPFStep = p.switches.hpfSetting;
-
-        _defaultVoiceParams = vp;
-        for (int i = 0; i < VOICE_COUNT; ++i) {
-            _voiceParams[i] = vp;
-            _voices[i].setParams(_voiceParams[i]);
-        }
 
-        // Chorus mode from patch
-        if (!p.switches.chorusOn) {
-            setChorusMode(0);
-        } else if (p.switches.chorusLevelII) {
-            setChorusMode(2);
-        } else {
-            setChorusMode(1);
-        }
+    void applyPatch(const Juno106::JunoPatch& p) {
+        _snapshot.update([&](Snapshot& s) {
+            VoiceParams& vp = s.voice;
+
+            // Map VCF
+            vp.cutoffHz   = Juno106::ParameterScaler::vcfCutoffToHz(p.vcfCutoff);
+            vp.resonance  = static_cast<float>(p.vcfResonance) / 127.0f;
+
+            // Envelope to filter amount (centered around 0.5 so negative values
+            // can be used when vcfEnvPositive is false)
+            const float envAmount = static_cast<float>(p.vcfEnvMod) / 127.0f;
+            vp.envToFilter = p.switches.vcfEnvPositive ? envAmount : -envAmount;
+
+            // LFO to filter
+            vp.lfoToFilter = static_cast<float>(p.vcfLfoMod) / 127.0f;
+            vp.lfoRateHz   = Juno106::ParameterScaler::lfoRateToHz(p.lfoRate);
+
+            // PWM depth: map 0‑127 to something musically useful (0–1 range)
+            vp.pwmDepth = static_cast<float>(p.dcoPwmDepth) / 127.0f;
+            vp.subLevel = static_cast<float>(p.dcoSubLevel) / 127.0f;
+
+            // Envelope times
+            vp.envAttack  = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envAttack, true);
+            vp.envDecay   = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envDecay, false);
+            vp.envRelease = Juno106::ParameterScaler::envelopeTimeToSeconds(p.envRelease, false);
+            vp.envSustain = static_cast<float>(p.envSustain) / 127.0f;
+
+            // Simple mapping for analog character / drift; these can later be
+            // refined to depend on patch age, chorus usage, etc.
+            vp.dcoBeating    = 0.5f + 0.5f * (static_cast<float>(p.dcoLfoMod) / 127.0f);
+            vp.filterDrift   = 0.5f;
+            vp.envelopeClick = 0.5f;
+            vp.filterTemp    = 0.5f;
+            vp.filterAge     = 0.3f;
+
+            // HPF steps: 0=off, 1=~80 Hz, 2=~160 Hz, 3=~360 Hz.
+            s.hpfStep = p.switches.hpfSetting;
+
+            // Chorus mode from patch
+            if (!p.switches.chorusOn) {
+                s.chorusMode = 0;
+            } else if (p.switches.chorusLevelII) {
+                s.chorusMode = 2;
+            } else {
+                s.chorusMode = 1;
+            }
+        });
     }
 
     float _sr = 44100.0f;
-    int   _currentNote = -1;
+    std::atomic<int> _currentNote{-1};
 
+    // Render-thread state, refreshed from _snapshot at block start.
     std::array<JunoVoice, VOICE_COUNT>   _voices;
     std::array<VoiceParams, VOICE_COUNT> _voiceParams;
-    VoiceParams _defaultVoiceParams = {
-        1000.0f,   // cutoffHz
-        0.2f,      // resonance
-        0.5f,      // envToFilter
-        0.2f,      // lfoToFilter
-        4.0f,      // lfoRateHz
-        0.5f,      // pwmDepth
-        0.01f,     // envAttack
-        0.2f,      // envDecay
-        0.7f,      // envSustain
-        0.4f,      // envRelease
-        0.7f,      // dcoBeating
-        0.8f,      // filterDrift
-        0.6f,      // envelopeClick
-        0.5f,      // filterTemp
-        0.3f       // filterAge
-    };
+    VoiceAllocator _allocator;
+    float _cableLength = -1.0f;
+    bool _flushDenormals = true;
+    AnalogTier _tier = AnalogTier::Standard;
+    int _oversampling = 1;
+    int _tailFrames = 0;          // chorus delay line length
+    long long _quietFrames = 0;   // frames since a voice last sounded
 
     // Global HPF mode for now (can be made per‑voice if desired)
     uint8_t _currentHPFStep = 0;
@@ -292,5 +414,7 @@ private:
     CableCapacitance _cableSim;
     BBDChorus        _chorus;
 
-    mutable std::mutex _mtx;
-};
+    // Control -> render channels.
+    TripleBuffer<Snapshot> _snapshot;
+    NoteEventQueue         _notes;
+};
\ No newline at end of file
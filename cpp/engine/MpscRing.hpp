@@ -0,0 +1,83 @@
+// ============================================================
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Bounded multi-producer/single-consumer ring (Vyukov's bounded queue), the
+// channel from control threads to the render thread in both engines (see
+// NoteEventQueue and the rtn EventQueue).
+//
+// Each cell carries a sequence number: producers claim a slot with one CAS
+// on the enqueue index and publish it by bumping the cell's sequence, so
+// concurrent producers never see a half-written value. Neither side blocks
+// or allocates; push() fails when the ring is full. Head, tail and the
+// cells live on separate cache lines.
+template <typename T, std::size_t Capacity>
+class MpscRing {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscRing capacity must be a power of two");
+    // Values are copied in and out of the cells; copying must not allocate.
+    static_assert(std::is_trivially_copyable<T>::value, "MpscRing holds plain data");
+    static constexpr std::size_t kCapacity = Capacity;
+
+    MpscRing() {
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    // Safe to call from any number of threads.
+    bool push(const T &value) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        for (;;) {
+            cell = &cells_[pos & (kCapacity - 1)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer (render thread) only.
+    bool pop(T &value) {
+        const std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell &cell = cells_[pos & (kCapacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false; // empty, or the next value is still being written
+        }
+        value = cell.value;
+        cell.sequence.store(pos + kCapacity, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value;
+    };
+
+    Cell cells_[kCapacity];
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos_{0};
+};
+
+
+// ============================================================
@@ -0,0 +1,23 @@
+// ============================================================
+
+#pragma once
+
+#include <cstdint>
+
+#include "engine/MpscRing.hpp"
+
+// Note on/off and aftertouch from control threads to the render thread.
+struct NoteEvent {
+    enum class Type : uint8_t { NoteOn, NoteOff, Aftertouch };
+
+    Type type = Type::NoteOn;
+    int32_t note = 0;    // MIDI note, or voice index for Aftertouch
+    float value = 0.0f;  // velocity or pressure
+};
+
+// Up to kCapacity events pending between two render() calls; push() fails
+// beyond that.
+using NoteEventQueue = MpscRing<NoteEvent, 256>;
+
+
+// ============================================================
@@ -0,0 +1,71 @@
+// ============================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Triple-buffered snapshot of a trivially copyable value, handed from
+// control threads to the render thread.
+//
+// Writers edit their own copy of the latest value and publish it by swapping
+// their back slot with the shared middle slot. The reader swaps the middle
+// slot with its front slot at block start, and only if something new was
+// published, so acquire() is a single atomic exchange: wait-free, and never
+// blocked by a writer no matter where that writer is preempted. Writers
+// serialise on a mutex the reader never touches.
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T &initial = T()) {
+        _slots.fill(initial);
+        _latest = initial;
+    }
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Control side. fn(T&) edits the latest value; the result is published.
+    template <typename Fn>
+    void update(Fn &&fn) {
+        std::lock_guard<std::mutex> g(_writeMtx);
+        fn(_latest);
+        _slots[_back] = _latest;
+        _back = _middle.exchange(_back | kDirty, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Control side. Latest published value, for read-modify-write callers.
+    T latest() const {
+        std::lock_guard<std::mutex> g(_writeMtx);
+        return _latest;
+    }
+
+    // Render side. Picks up the newest published value; returns true if it
+    // differs from the one read() returned before.
+    bool acquire() {
+        if ((_middle.load(std::memory_order_relaxed) & kDirty) == 0) {
+            return false;
+        }
+        _front = _middle.exchange(_front, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    // Render side.
+    const T &read() const { return _slots[_front]; }
+
+private:
+    static constexpr uint32_t kDirty = 0x4u;
+    static constexpr uint32_t kIndexMask = 0x3u;
+
+    std::array<T, 3> _slots;
+    alignas(64) std::atomic<uint32_t> _middle{1};
+    alignas(64) uint32_t _front = 0;   // render thread only
+    alignas(64) uint32_t _back = 2;    // under _writeMtx
+    T _latest;                         // under _writeMtx
+    mutable std::mutex _writeMtx;
+};
+
+
+// ============================================================
@@ -0,0 +1,270 @@
+// ============================================================
+
+#pragma once
+#include <algorithm>
+#include <vector>
+
+// Voice assignment without scans.
+//
+// Every voice is on exactly one intrusive list: free (idle), held (key down,
+// in note-on order), released (key up but still sounding, in note-off
+// order) or parked (above the voice limit, never handed out). Voices
+// playing the same MIDI note are also chained per note, so note-off finds
+// its voice without looking at the others. Everything is sized in
+// initialize(); noteOn/noteOff/reclaim never allocate and, except for the
+// Quietest policy, run in constant time.
+//
+// Duplicate notes: each note-on takes its own voice and each note-off
+// releases the oldest still-held instance, so two presses of one key need
+// two releases. With SameNoteRetrigger the second press restarts the voice
+// already playing the note instead and counts as one more press to release.
+class VoiceAllocator {
+public:
+    enum class Policy {
+        Oldest,             // free voice, else the longest-released, else the oldest held
+        Quietest,           // free voice, else the quietest released, else the quietest held
+        RoundRobin,         // strict rotation like the 106's Poly 1; tails ring until reused
+        SameNoteRetrigger   // reuse the voice already playing the note, else Oldest
+    };
+
+    static constexpr int kNoteCount = 128;
+
+    // Not real-time safe; call from setup code.
+    void initialize(int numVoices) {
+        numVoices_ = std::max(numVoices, 0);
+        voices_.assign(static_cast<std::size_t>(numVoices_), Voice{});
+        for (auto &l : lists_) l = List{};
+        std::fill(std::begin(noteHead_), std::end(noteHead_), -1);
+        std::fill(std::begin(noteTail_), std::end(noteTail_), -1);
+        for (int v = 0; v < numVoices_; ++v) pushBack(Free, v);
+        limit_ = numVoices_;
+        cursor_ = 0;
+    }
+
+    // Caps how many voices are handed out, e.g. to shed load. Voices at or
+    // above the limit are parked; `silence(voice)` is called for each one
+    // that was still held or releasing so the caller can fade it out.
+    // Raising the limit frees parked voices again. O(voices), so call it
+    // when the limit changes rather than per block.
+    template <typename SilenceFn>
+    void setLimit(int limit, SilenceFn silence) {
+        limit_ = std::clamp(limit, std::min(numVoices_, 1), numVoices_);
+        for (int v = 0; v < numVoices_; ++v) {
+            Voice &voice = voices_[static_cast<std::size_t>(v)];
+            if (v < limit_) {
+                if (voice.state == Parked) {
+                    unlink(Parked, v);
+                    pushBack(Free, v);
+                }
+                continue;
+            }
+            if (voice.state == Parked) continue;
+            const bool sounding = voice.state != Free;
+            unlinkNote(v);
+            unlink(voice.state, v);
+            pushBack(Parked, v);
+            voice.note = -1;
+            voice.presses = 0;
+            if (sounding) silence(v);
+        }
+        if (cursor_ >= limit_) cursor_ = 0;
+    }
+
+    int limit() const { return limit_; }
+
+    void setPolicy(Policy p) { policy_ = p; }
+    Policy policy() const { return policy_; }
+
+    int size() const { return numVoices_; }
+    int heldCount() const { return lists_[Held].count; }
+    int freeCount() const { return lists_[Free].count; }
+    bool isHeld(int voice) const { return voices_[static_cast<std::size_t>(voice)].state == Held; }
+    bool isFree(int voice) const { return voices_[static_cast<std::size_t>(voice)].state == Free; }
+    // MIDI note the voice was last assigned, or -1 once it is free.
+    int note(int voice) const { return voices_[static_cast<std::size_t>(voice)].note; }
+
+    // Picks the voice for `note` and records it as held. The caller starts
+    // the note on the returned voice, cutting off whatever it was playing.
+    // `level(voice)` is only consulted by Quietest. Returns -1 only when the
+    // allocator has no voices.
+    template <typename LevelFn>
+    int noteOn(int note, LevelFn level) {
+        if (numVoices_ == 0 || note < 0 || note >= kNoteCount) return -1;
+
+        if (policy_ == Policy::SameNoteRetrigger && noteTail_[note] >= 0) {
+            const int v = noteTail_[note];
+            Voice &voice = voices_[static_cast<std::size_t>(v)];
+            voice.presses = (voice.state == Held) ? voice.presses + 1 : 1;
+            unlink(voice.state, v);
+            pushBack(Held, v);
+            return v;
+        }
+
+        const int v = pick(level);
+        assign(v, note);
+        return v;
+    }
+
+    int noteOn(int note) {
+        return noteOn(note, [](int) { return 0.0f; });
+    }
+
+    // Releases one press of `note`. Returns the voice whose key went up, or
+    // -1 if none is held for `note` (already released, stolen, or still
+    // held by an earlier duplicate press under SameNoteRetrigger).
+    int noteOff(int note) {
+        if (note < 0 || note >= kNoteCount) return -1;
+        for (int v = noteHead_[note]; v >= 0; v = voices_[static_cast<std::size_t>(v)].noteNext) {
+            Voice &voice = voices_[static_cast<std::size_t>(v)];
+            if (voice.state != Held) continue;
+            if (--voice.presses > 0) return -1;
+            unlink(Held, v);
+            pushBack(Released, v);
+            return v;
+        }
+        return -1;
+    }
+
+    // Returns released voices that have gone silent to the free list.
+    // `isActive(voice)` is asked once per released voice, so calling this
+    // once per block costs O(voices in release).
+    template <typename ActiveFn>
+    void reclaim(ActiveFn isActive) {
+        int v = lists_[Released].head;
+        while (v >= 0) {
+            const int next = voices_[static_cast<std::size_t>(v)].next;
+            if (!isActive(v)) retire(v);
+            v = next;
+        }
+    }
+
+    // The voice stopped on its own or was cut (e.g. all-notes-off).
+    void retire(int voice) {
+        Voice &v = voices_[static_cast<std::size_t>(voice)];
+        if (v.state == Free || v.state == Parked) return;
+        unlinkNote(voice);
+        unlink(v.state, voice);
+        pushBack(Free, voice);
+        v.note = -1;
+        v.presses = 0;
+    }
+
+private:
+    enum State { Free = 0, Held = 1, Released = 2, Parked = 3 };
+
+    struct Voice {
+        State state = Free;
+        int prev = -1, next = -1;           // links in the state list
+        int notePrev = -1, noteNext = -1;   // links in the per-note chain
+        int note = -1;
+        int presses = 0;
+    };
+
+    struct List {
+        int head = -1;
+        int tail = -1;
+        int count = 0;
+    };
+
+    template <typename LevelFn>
+    int pick(LevelFn level) {
+        if (policy_ == Policy::RoundRobin) {
+            const int v = cursor_;
+            cursor_ = (cursor_ + 1) % limit_;
+            return v;
+        }
+        if (lists_[Free].head >= 0) return lists_[Free].head;
+
+        const State from = (lists_[Released].head >= 0) ? Released : Held;
+        if (policy_ != Policy::Quietest) return lists_[from].head;
+
+        int best = lists_[from].head;
+        float bestLevel = level(best);
+        for (int v = voices_[static_cast<std::size_t>(best)].next; v >= 0;
+             v = voices_[static_cast<std::size_t>(v)].next) {
+            const float l = level(v);
+            if (l < bestLevel) {
+                bestLevel = l;
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    void assign(int v, int note) {
+        Voice &voice = voices_[static_cast<std::size_t>(v)];
+        unlinkNote(v);
+        unlink(voice.state, v);
+        pushBack(Held, v);
+        voice.note = note;
+        voice.presses = 1;
+        voice.notePrev = noteTail_[note];
+        voice.noteNext = -1;
+        if (noteTail_[note] >= 0) {
+            voices_[static_cast<std::size_t>(noteTail_[note])].noteNext = v;
+        } else {
+            noteHead_[note] = v;
+        }
+        noteTail_[note] = v;
+    }
+
+    void unlinkNote(int v) {
+        Voice &voice = voices_[static_cast<std::size_t>(v)];
+        if (voice.note < 0) return;
+        if (voice.notePrev >= 0) {
+            voices_[static_cast<std::size_t>(voice.notePrev)].noteNext = voice.noteNext;
+        } else {
+            noteHead_[voice.note] = voice.noteNext;
+        }
+        if (voice.noteNext >= 0) {
+            voices_[static_cast<std::size_t>(voice.noteNext)].notePrev = voice.notePrev;
+        } else {
+            noteTail_[voice.note] = voice.notePrev;
+        }
+        voice.notePrev = voice.noteNext = -1;
+    }
+
+    void pushBack(State s, int v) {
+        Voice &voice = voices_[static_cast<std::size_t>(v)];
+        List &list = lists_[s];
+        voice.state = s;
+        voice.prev = list.tail;
+        voice.next = -1;
+        if (list.tail >= 0) {
+            voices_[static_cast<std::size_t>(list.tail)].next = v;
+        } else {
+            list.head = v;
+        }
+        list.tail = v;
+        ++list.count;
+    }
+
+    void unlink(State s, int v) {
+        Voice &voice = voices_[static_cast<std::size_t>(v)];
+        List &list = lists_[s];
+        if (voice.prev >= 0) {
+            voices_[static_cast<std::size_t>(voice.prev)].next = voice.next;
+        } else {
+            list.head = voice.next;
+        }
+        if (voice.next >= 0) {
+            voices_[static_cast<std::size_t>(voice.next)].prev = voice.prev;
+        } else {
+            list.tail = voice.prev;
+        }
+        voice.prev = voice.next = -1;
+        --list.count;
+    }
+
+    Policy policy_ = Policy::Oldest;
+    int numVoices_ = 0;
+    int limit_ = 0;
+    int cursor_ = 0;
+    std::vector<Voice> voices_;
+    List lists_[4];
+    int noteHead_[kNoteCount] = {};
+    int noteTail_[kNoteCount] = {};
+};
+
+
+// ============================================================
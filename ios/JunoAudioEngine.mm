@@ -64,12 +64,13 @@
         float *left = (float *)outputData->mBuffers[0].mData;
         float *right = (float *)outputData->mBuffers[1].mData;
 #ifdef __cplusplus
-        _engine->render(left, right, (int)frameCount);
+        const bool silent = _engine->render(left, right, (int)frameCount);
+        *isSilence = silent ? YES : NO;
 #else
         memset(left, 0, sizeof(float) * frameCount);
         memset(right, 0, sizeof(float) * frameCount);
+        *isSilence = YES;
 #endif
-        *isSilence = NO;
         return noErr;
     }];
 
@@ -1,5 +1,6 @@
 #include "JunoAudioEngine.hpp"
 #include <algorithm>
+#include <cstring>
 
 JunoAudioEngine::JunoAudioEngine() {
     dsp_ = std::make_unique<JunoDSPEngine>();
@@ -20,7 +21,9 @@ bool JunoAudioEngine::start(int sr, int bs) {
         dsp_ = std::make_unique<JunoDSPEngine>();
     }
 
-    // Android path uses CPU DSP only (no GPU).
+    // Android path uses CPU DSP only (no GPU). Weak devices shed filter
+    // detail and voices under load instead of glitching.
+    dsp_->setAdaptiveQuality(true);
 
     if (!dsp_->initialize(sr, bs, 8, false)) {
         return false;
@@ -106,7 +109,13 @@ JunoAudioEngine::renderCB(AAudioStream* /*stream*/,
 
     float* buffer = static_cast<float*>(audioData);
 
-    self->dsp_->renderAudio(self->leftBuffer_.data(), self->rightBuffer_.data(), frames);
+    const bool silent =
+        self->dsp_->renderAudio(self->leftBuffer_.data(), self->rightBuffer_.data(), frames);
+    if (silent) {
+        // Nothing sounding: skip the interleave.
+        std::memset(buffer, 0, sizeof(float) * 2 * static_cast<size_t>(frames));
+        return AAUDIO_CALLBACK_RESULT_CONTINUE;
+    }
 
     for (int i = 0; i < frames; ++i) {
         buffer[i * 2]     = self->leftBuffer_[i];
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include "FastMath.hpp"
 
 class BBDChorus {
 public:
@@ -33,6 +34,19 @@ public:
     void setMode(Mode m) { mode_ = m; }
     Mode mode() const { return mode_; }
 
+    // Frames after the input goes silent until the delay line has played
+    // out; past that only the clock noise is left.
+    int tailFrames() const { return static_cast<int>(buffer_.size()); }
+
+    // 0 = Off, 1 = Chorus I, 2 = Chorus II (anything else is Off).
+    static Mode modeFromIndex(int index) {
+        switch (index) {
+            case 1:  return Mode::I;
+            case 2:  return Mode::II;
+            default: return Mode::Off;
+        }
+    }
+
     void reset() {
         std::fill(buffer_.begin(), buffer_.end(), 0.0f);
         writeIndex_ = 0;
@@ -60,8 +74,8 @@ public:
         const float lfoRateR = 1.2f;  // Hz
 
         // Sine LFOs in [-1, 1]
-        float lfoL = std::sin(2.0f * kPi * lfoPhaseL_);
-        float lfoR = std::sin(2.0f * kPi * lfoPhaseR_);
+        float lfoL = fastmath::sin2pi(lfoPhaseL_);
+        float lfoR = fastmath::sin2pi(lfoPhaseR_);
 
         float delayL = baseDelay + depth * lfoL;
         float delayR = baseDelay + depth * lfoR;
@@ -86,6 +100,18 @@ public:
         if (lfoPhaseR_ >= 1.0f) lfoPhaseR_ -= 1.0f;
     }
 
+    // Block form of process(): mono `in` to stereo `outL`/`outR`. `outL`
+    // may alias `in`.
+    void processBlock(const float *in, float *outL, float *outR, int n) {
+        for (int i = 0; i < n; ++i) {
+            float l = 0.0f;
+            float r = 0.0f;
+            process(in[i], l, r);
+            outL[i] = l;
+            outR[i] = r;
+        }
+    }
+
 private:
     float sr_ = 44100.0f;
     Mode  mode_ = Mode::Off;
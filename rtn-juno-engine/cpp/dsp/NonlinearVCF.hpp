@@ -1,6 +1,7 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include "FastMath.hpp"
 
 class NonlinearVCF {
 public:
@@ -26,7 +27,7 @@ public:
 
         const float fc = cutoffHz / sampleRate_;
         // bilinear transform approx for one-pole
-        const float x = std::exp(-2.0f * kPi * fc);
+        const float x = fastmath::exp(-2.0f * kPi * fc);
         const float g = 1.0f - x;
 
         // Simple feedback from last stage
@@ -41,14 +42,97 @@ public:
         return softClip(stage_[3]);
     }
 
-private:
-    float sampleRate_ = 44100.0f;
-    float stage_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    // Filters `n` samples in place. Coefficients are computed once for the
+    // block and the stage state is kept in locals until the block is done;
+    // results are identical to calling process() per sample.
+    void processBlock(float *buffer, int n, float cutoffHz, float resonance) {
+        if (sampleRate_ <= 0.0f || !buffer || n <= 0) return;
+
+        const float g = stageGain(cutoffHz, sampleRate_);
+        const float fb = feedbackGain(resonance);
+
+        float s0 = stage_[0];
+        float s1 = stage_[1];
+        float s2 = stage_[2];
+        float s3 = stage_[3];
+
+        for (int i = 0; i < n; ++i) {
+            const float x_in = softClip(buffer[i] - fb * s3);
+            s0 = s0 + g * (x_in - s0);
+            s1 = s1 + g * (s0 - s1);
+            s2 = s2 + g * (s1 - s2);
+            s3 = s3 + g * (s2 - s3);
+            buffer[i] = softClip(s3);
+        }
+
+        stage_[0] = s0;
+        stage_[1] = s1;
+        stage_[2] = s2;
+        stage_[3] = s3;
+    }
+
+    // As processBlock(), but with the coefficients moving linearly across the
+    // block: before each sample `gain += gainStep` and `fb += fbStep`, and
+    // the final values are written back so a ramp can continue in the next
+    // call. Takes stage-ready values from stageGain()/feedbackGain(), so a
+    // smoothed sweep costs no exp() per sample.
+    void processBlockRamped(float *buffer, int n, float &gain, float gainStep,
+                            float &fb, float fbStep) {
+        if (sampleRate_ <= 0.0f || !buffer || n <= 0) return;
+
+        float s0 = stage_[0];
+        float s1 = stage_[1];
+        float s2 = stage_[2];
+        float s3 = stage_[3];
+
+        for (int i = 0; i < n; ++i) {
+            gain += gainStep;
+            fb += fbStep;
+            const float x_in = softClip(buffer[i] - fb * s3);
+            s0 = s0 + gain * (x_in - s0);
+            s1 = s1 + gain * (s0 - s1);
+            s2 = s2 + gain * (s1 - s2);
+            s3 = s3 + gain * (s2 - s3);
+            buffer[i] = softClip(s3);
+        }
+
+        stage_[0] = s0;
+        stage_[1] = s1;
+        stage_[2] = s2;
+        stage_[3] = s3;
+    }
+
+    // One-pole stage gain for a cutoff, shared with vectorised callers that
+    // keep the stage state themselves (see VoiceBank).
+    static inline float stageGain(float cutoffHz, float sampleRate) {
+        cutoffHz = std::clamp(cutoffHz, 20.0f, sampleRate * 0.45f);
+        const float fc = cutoffHz / sampleRate;
+        const float x = fastmath::exp(-2.0f * kPi * fc);
+        return 1.0f - x;
+    }
+
+    static inline float feedbackGain(float resonance) {
+        return std::clamp(resonance, 0.0f, 1.2f) * 3.5f;
+    }
 
     static inline float softClip(float x) {
         // tanh-style soft clip
-        return std::tanh(x * 1.5f);
+        return fastmath::tanh(x * 1.5f);
     }
 
+    // softClip() without the tanh: a rational (Pade) fit that is exact at 0,
+    // within 0.025 of tanh up to the clamp at |x * 1.5| = 3 and hard-limits
+    // beyond. For shedding load; the loss shows up as slightly harder
+    // saturation.
+    static inline float fastSoftClip(float x) {
+        const float y = std::clamp(x * 1.5f, -3.0f, 3.0f);
+        const float y2 = y * y;
+        return y * (27.0f + y2) / (27.0f + 9.0f * y2);
+    }
+
+private:
+    float sampleRate_ = 44100.0f;
+    float stage_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
     static inline constexpr float kPi = 3.14159265358979323846f;
 };
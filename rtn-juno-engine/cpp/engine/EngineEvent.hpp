@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Engine parameters addressable from the control side. Names match the ids
+// accepted by JunoDSPEngine::setParameter().
+enum class ParamId : std::uint8_t {
+    Cutoff,
+    Resonance,
+    Attack,
+    Decay,
+    Sustain,
+    Release,
+    PwmDepth,
+    SubLevel,
+    ChorusMode,
+    Count
+};
+
+inline const char *paramName(ParamId id) {
+    switch (id) {
+        case ParamId::Cutoff:     return "cutoff";
+        case ParamId::Resonance:  return "resonance";
+        case ParamId::Attack:     return "attack";
+        case ParamId::Decay:      return "decay";
+        case ParamId::Sustain:    return "sustain";
+        case ParamId::Release:    return "release";
+        case ParamId::PwmDepth:   return "pwmDepth";
+        case ParamId::SubLevel:   return "subLevel";
+        case ParamId::ChorusMode: return "chorusMode";
+        default:                  return "";
+    }
+}
+
+// Returns false for unknown ids.
+inline bool paramIdFromString(const std::string &name, ParamId &out) {
+    for (int i = 0; i < static_cast<int>(ParamId::Count); ++i) {
+        const auto id = static_cast<ParamId>(i);
+        if (name == paramName(id)) {
+            out = id;
+            return true;
+        }
+    }
+    return false;
+}
+
+// A note or parameter change queued for the audio thread. Plain data so it
+// can be copied through a lock-free ring without allocating.
+struct EngineEvent {
+    enum class Type : std::uint8_t {
+        NoteOn,
+        NoteOff,
+        Parameter
+    };
+
+    // How `time` is interpreted when the audio thread picks the event up.
+    enum class TimeBase : std::uint8_t {
+        Immediate,   // start of the next rendered block
+        Sample,      // absolute engine sample time
+        HostNanos    // host clock in nanoseconds, same clock as renderAudio()
+    };
+
+    Type         type  = Type::NoteOn;
+    TimeBase     base  = TimeBase::Immediate;
+    ParamId      param = ParamId::Cutoff;
+    std::int32_t note  = 0;
+    float        value = 0.0f;   // velocity or parameter value
+    std::int64_t time  = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// ADSR shared by VoiceBank's lanes and the scalar JunoVoice.
+//
+// Each segment is a one-pole approach, level += (target - level) * step,
+// whose target and step are set when the segment starts or when its
+// parameter changes (steps come from EnvelopeSteps). Per sample an envelope
+// is one multiply-add plus the attack-to-decay handover, with no exp().
+// Stages are floats so lane loops can select on them.
+namespace EnvelopeStage {
+constexpr float Idle    = 0.0f;
+constexpr float Attack  = 1.0f;   // towards 1.0
+constexpr float Decay   = 2.0f;   // towards sustain, then holds there
+constexpr float Release = 3.0f;   // towards 0.0
+}
+
+// The attack only approaches 1.0, so it hands over to the decay here.
+constexpr float kAttackPeak = 0.99f;
+
+// Advances one envelope by a sample and returns the new level. At the
+// attack peak the segment becomes the decay towards `sustain`.
+inline float stepEnvelope(float level, float &target, float &step, float &stage,
+                          float sustain, float decayStep) {
+    const float next = level + (target - level) * step;
+    const bool peaked = stage == EnvelopeStage::Attack && next >= kAttackPeak;
+    target = peaked ? sustain : target;
+    step   = peaked ? decayStep : step;
+    stage  = peaked ? EnvelopeStage::Decay : stage;
+    return next;
+}
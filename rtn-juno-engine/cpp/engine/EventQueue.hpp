@@ -0,0 +1,7 @@
+#pragma once
+#include "EngineEvent.hpp"
+#include "MpscRing.hpp"
+
+// The only channel from control threads (UI, JNI, MIDI) to the audio
+// thread; see MpscRing (cpp/engine) for the protocol.
+using EventQueue = MpscRing<EngineEvent, 1024>;
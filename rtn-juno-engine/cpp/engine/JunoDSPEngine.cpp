@@ -7,8 +7,12 @@
 #include "../ios/JunoRenderEngine.hpp"
 #endif
 #include "../parser/Juno106PatchParser.hpp"
+#include "DenormalGuard.hpp"
+#include "PatchCurves.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <limits>
 
 bool JunoDSPEngine::initialize(int sr, int bs, int poly, bool gpuFlag) {
     if (poly <= 0) {
@@ -22,13 +26,39 @@ bool JunoDSPEngine::initialize(int sr, int bs, int poly, bool gpuFlag) {
     useGPU_ = false;
 #endif
 
-    voices_.clear();
-    voices_.reserve(poly);
-    for (int i = 0; i < poly; ++i) {
-        auto v = std::make_unique<JunoVoice>();
-        v->initialize(sampleRate_);
-        voices_.push_back(std::move(v));
+    blockFrames_ = std::clamp(bs, 1, kMaxBlockFrames);
+    const bool perVoiceChorus = chorusRouting_ == ChorusRouting::PerVoice;
+    voices_.initialize(static_cast<float>(sampleRate_), poly, blockFrames_, perVoiceChorus);
+    voices_.setOversampling(oversampling_);
+    allocator_.initialize(poly);
+    // Level 1 is the cheaper filter; every level after it drops a lane group.
+    const int shedVoices = poly - voiceLimitFor(std::numeric_limits<int>::max());
+    const int shedGroups = (shedVoices + VoiceBank::kLanes - 1) / VoiceBank::kLanes;
+    governor_.configure(governorConfig_, adaptiveQuality_ ? 1 + shedGroups : 0);
+    applyQualityLevel(0);
+    renderLoad_.store(0.0f, std::memory_order_relaxed);
+    voiceScratch_.assign(static_cast<std::size_t>(poly) * 2 * blockFrames_, 0.0f);
+    busScratch_.assign(static_cast<std::size_t>(blockFrames_), 0.0f);
+    chorus_.configure(static_cast<float>(sampleRate_));
+    chorus_.setMode(BBDChorus::Mode::I);
+
+    // Threads are spawned here, never on the audio thread. A single voice
+    // group has nothing to share out.
+    const int usefulWorkers = std::min(workerThreads_, voices_.groupCount() - 1);
+    if (!workers_.start(std::max(usefulWorkers, 0))) {
+        workers_.stop();
     }
+    groupRendered_.assign(static_cast<std::size_t>(voices_.groupCount()), 0u);
+    // Nothing has played yet, so there is no tail either.
+    quietFrames_ = std::numeric_limits<std::int32_t>::max();
+
+    pending_.clear();
+    pending_.reserve(kMaxPendingEvents);
+    droppedEvents_.store(0, std::memory_order_relaxed);
+    sampleTime_.store(0, std::memory_order_release);
+    // Re-apply stored parameters to the fresh voices on the first block.
+    appliedSerial_.fill(std::numeric_limits<std::uint32_t>::max());
+    appliedParams_.fill(std::numeric_limits<float>::quiet_NaN());
 
     if (useGPU_) {
 #if defined(__APPLE__) && defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE
@@ -38,7 +68,8 @@ bool JunoDSPEngine::initialize(int sr, int bs, int poly, bool gpuFlag) {
             useGPU_ = false;
             gpuVoiceCache_.reset();
         } else {
-            gpuVoiceCache_ = std::make_unique<std::vector<VoiceGPUParams>>(voices_.size());
+            gpuVoiceCache_ = std::make_unique<std::vector<VoiceGPUParams>>(
+                static_cast<std::size_t>(voices_.size()));
         }
 #else
         useGPU_ = false;
@@ -53,67 +84,254 @@ void JunoDSPEngine::start()  { running_.store(true, std::memory_order_release);
 void JunoDSPEngine::stop()   { running_.store(false, std::memory_order_release); }
 
 void JunoDSPEngine::noteOn(int note, float vel) {
-    if (voices_.empty()) {
-        return;
-    }
+    EngineEvent e;
+    e.type  = EngineEvent::Type::NoteOn;
+    e.note  = note;
+    e.value = vel;
+    scheduleEvent(e);
+}
+
+void JunoDSPEngine::noteOff(int note) {
+    EngineEvent e;
+    e.type = EngineEvent::Type::NoteOff;
+    e.note = note;
+    scheduleEvent(e);
+}
+
+void JunoDSPEngine::setParameter(ParamId id, float v) {
+    setParameterAt(id, v, -1);
+}
+
+void JunoDSPEngine::setParameter(const std::string &id, float v) {
+    setParameterAt(id, v, -1);
+}
 
-    // Basic voice allocation: first free voice, else steal voice 0
-    auto it = std::find_if(
-        voices_.begin(),
-        voices_.end(),
-        [](const std::unique_ptr<JunoVoice> &v) { return !v->isActive(); }
-    );
-    if (it == voices_.end()) {
-        it = voices_.begin();
+void JunoDSPEngine::noteOnAt(int note, float vel, std::int64_t sampleTime) {
+    EngineEvent e;
+    e.type  = EngineEvent::Type::NoteOn;
+    e.base  = EngineEvent::TimeBase::Sample;
+    e.note  = note;
+    e.value = vel;
+    e.time  = sampleTime;
+    scheduleEvent(e);
+}
+
+void JunoDSPEngine::noteOffAt(int note, std::int64_t sampleTime) {
+    EngineEvent e;
+    e.type = EngineEvent::Type::NoteOff;
+    e.base = EngineEvent::TimeBase::Sample;
+    e.note = note;
+    e.time = sampleTime;
+    scheduleEvent(e);
+}
+
+void JunoDSPEngine::setParameterAt(const std::string &id, float v, std::int64_t sampleTime) {
+    ParamId param;
+    if (paramIdFromString(id, param)) {
+        setParameterAt(param, v, sampleTime);
     }
-    (*it)->noteOn(note, vel);
 }
 
-void JunoDSPEngine::noteOff(int note) {
-    for (auto &v : voices_) {
-        if (!v->isActive()) continue;
-        v->noteOff(note);
-        if (!v->isActive()) {
-            break; // Release a single matching voice
+void JunoDSPEngine::setParameterAt(ParamId id, float v, std::int64_t sampleTime) {
+    if (sampleTime >= 0) {
+        EngineEvent e;
+        e.type  = EngineEvent::Type::Parameter;
+        e.base  = EngineEvent::TimeBase::Sample;
+        e.param = id;
+        e.value = v;
+        e.time  = sampleTime;
+        if (scheduleEvent(e)) {
+            return;
         }
+        // Queue full: apply at the next block rather than lose the change.
     }
+    // Immediate changes coalesce in the parameter store, so a burst of any
+    // size keeps the last value of every parameter.
+    params_.set(id, v);
+    paramSerial_[static_cast<std::size_t>(id)].fetch_add(1, std::memory_order_release);
 }
 
-void JunoDSPEngine::setParameter(const std::string &id, float v) {
-    params_.set(id, v);
+bool JunoDSPEngine::scheduleEvent(const EngineEvent &e) {
+    return events_.push(e);
 }
 
 void JunoDSPEngine::loadPatch(const Juno106::JunoPatch &p) {
     auto map01 = [](unsigned char v) {
         return static_cast<float>(v) / 127.0f;
     };
+    // The exponential sliders are compile-time tables (PatchCurves.hpp), so a
+    // patch load does no transcendental math.
+    auto curve = [](const Juno106::CurveTable &table, unsigned char v) {
+        return table[std::min<std::size_t>(v, table.size() - 1)];
+    };
 
-    float cutoffNorm    = map01(p.vcfCutoff);
-    float cutoffHz      = std::exp(std::log(50.0f) +
-                             (std::log(15000.0f) - std::log(50.0f)) * cutoffNorm);
-
+    float cutoffHz      = Juno106::ParameterScaler::vcfCutoffToHz(p.vcfCutoff);
     float resonanceNorm = map01(p.vcfResonance);
-    float attackTime    = 0.0015f * std::pow(10.0f, map01(p.envAttack) * 3.0f);
-    float releaseTime   = 0.0015f * std::pow(10.0f, map01(p.envRelease) * 3.6f);
+    float attackTime    = curve(PatchCurves::kAttackSeconds, p.envAttack);
+    float decayTime     = curve(PatchCurves::kReleaseSeconds, p.envDecay);
+    float sustainNorm   = map01(p.envSustain);
+    float releaseTime   = curve(PatchCurves::kReleaseSeconds, p.envRelease);
     float subLevel      = map01(p.dcoSubLevel);
 
-    setParameter("cutoff",    cutoffHz);
-    setParameter("resonance", resonanceNorm);
-    setParameter("attack",    attackTime);
-    setParameter("release",   releaseTime);
-    setParameter("subLevel",  subLevel);
+    setParameter(ParamId::Cutoff,     cutoffHz);
+    setParameter(ParamId::Resonance,  resonanceNorm);
+    setParameter(ParamId::Attack,     attackTime);
+    setParameter(ParamId::Decay,      decayTime);
+    setParameter(ParamId::Sustain,    sustainNorm);
+    setParameter(ParamId::Release,    releaseTime);
+    setParameter(ParamId::SubLevel,   subLevel);
+
+    // 0 = Off, 1 = Chorus I, 2 = Chorus II
+    const float chorusMode = !p.switches.chorusOn ? 0.0f
+                           : (p.switches.chorusLevelII ? 2.0f : 1.0f);
+    setParameter(ParamId::ChorusMode, chorusMode);
+}
+
+bool JunoDSPEngine::renderAudio(float *L, float *R, int n) {
+    if (!L || !R || n <= 0) return true;
+    if (!running_.load(std::memory_order_acquire)) {
+        std::fill(L, L + n, 0.0f);
+        std::fill(R, R + n, 0.0f);
+        return true;
+    }
+    return renderTimed(L, R, n, false, 0);
+}
+
+bool JunoDSPEngine::renderAudio(float *L, float *R, int n, std::uint64_t hostTimeNanos) {
+    if (!L || !R || n <= 0) return true;
+    if (!running_.load(std::memory_order_acquire)) {
+        std::fill(L, L + n, 0.0f);
+        std::fill(R, R + n, 0.0f);
+        return true;
+    }
+    return renderTimed(L, R, n, true, hostTimeNanos);
+}
+
+bool JunoDSPEngine::renderTimed(float *L, float *R, int n,
+                                bool hasHostTime, std::uint64_t hostTimeNanos) {
+    if (governor_.maxLevel() == 0) {
+        return renderBlock(L, R, n, hasHostTime, hostTimeNanos);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const bool silent = renderBlock(L, R, n, hasHostTime, hostTimeNanos);
+    const std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+
+    // A new level applies from the next callback, at a block boundary.
+    if (governor_.update(spent.count(), static_cast<double>(n) / sampleRate_)) {
+        applyQualityLevel(governor_.level());
+    }
+    renderLoad_.store(governor_.load(), std::memory_order_relaxed);
+    return silent;
+}
+
+int JunoDSPEngine::voiceLimitFor(int level) const {
+    const int poly = voices_.size();
+    const int minVoices = std::min(poly, VoiceBank::kLanes);
+    if (level <= 1) return poly;
+    const long long shed = static_cast<long long>(level - 1) * VoiceBank::kLanes;
+    return static_cast<int>(std::max<long long>(minVoices, poly - shed));
+}
+
+void JunoDSPEngine::applyQualityLevel(int level) {
+    voices_.setQuality(level >= 1 ? VoiceBank::Quality::Eco : VoiceBank::Quality::Full);
+    allocator_.setLimit(voiceLimitFor(level), [this](int v) { voices_.fadeOut(v); });
+    qualityLevel_.store(level, std::memory_order_relaxed);
+}
+
+void JunoDSPEngine::collectEvents(std::int64_t blockStart, bool hasHostTime,
+                                  std::uint64_t hostTimeNanos) {
+    EngineEvent e;
+    while (events_.pop(e)) {
+        std::int64_t t = blockStart;
+        if (e.base == EngineEvent::TimeBase::Sample) {
+            t = e.time;
+        } else if (e.base == EngineEvent::TimeBase::HostNanos && hasHostTime) {
+            const double deltaNs = static_cast<double>(e.time) -
+                                   static_cast<double>(hostTimeNanos);
+            t = blockStart + std::llround(deltaNs * 1e-9 * sampleRate_);
+        }
+        e.base = EngineEvent::TimeBase::Sample;
+        e.time = t;
+
+        if (pending_.size() >= pending_.capacity()) {
+            // Never allocate on the audio thread. A due event can still be
+            // applied on time, at the block start; a future one cannot be
+            // held, so it is dropped rather than played early.
+            if (t <= blockStart) {
+                applyEvent(e);
+            } else {
+                droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        // Keep pending_ sorted; equal times stay in arrival order.
+        auto pos = pending_.end();
+        while (pos != pending_.begin() && (pos - 1)->time > t) --pos;
+        pending_.insert(pos, e);
+    }
+}
+
+void JunoDSPEngine::applyEvent(const EngineEvent &e) {
+    switch (e.type) {
+        case EngineEvent::Type::NoteOn:    startNote(e.note, e.value); break;
+        case EngineEvent::Type::NoteOff:   releaseNote(e.note); break;
+        case EngineEvent::Type::Parameter: applyParameter(e.param, e.value); break;
+    }
+}
+
+void JunoDSPEngine::startNote(int note, float vel) {
+    const int voice = allocator_.noteOn(note, [this](int v) {
+        return voices_.envelopeLevel(v) * voices_.velocity(v);
+    });
+    if (voice >= 0) {
+        voices_.noteOn(voice, note, vel);
+    }
+}
+
+void JunoDSPEngine::releaseNote(int note) {
+    const int voice = allocator_.noteOff(note);
+    if (voice >= 0) {
+        voices_.noteOff(voice, note);
+    }
 }
 
-void JunoDSPEngine::renderAudio(float *L, float *R, int n) {
-    if (!running_.load(std::memory_order_acquire) || !L || !R || n <= 0) return;
+void JunoDSPEngine::reclaimVoices() {
+    allocator_.reclaim([this](int v) { return voices_.isActive(v); });
+}
 
-    // Apply any pending parameter changes on the audio thread to avoid races.
-    RCUParameterManager::ParamChange change;
-    while (params_.tryPop(change)) {
-        for (auto &voice : voices_) {
-            voice->setParam(change.id, change.value);
+void JunoDSPEngine::applyStoredParameters() {
+    for (std::size_t i = 0; i < appliedParams_.size(); ++i) {
+        const std::uint32_t serial = paramSerial_[i].load(std::memory_order_acquire);
+        if (serial == appliedSerial_[i]) {
+            continue;
+        }
+        appliedSerial_[i] = serial;
+        const auto id = static_cast<ParamId>(i);
+        const float value = params_.get(id, std::numeric_limits<float>::quiet_NaN());
+        if (!std::isnan(value)) {
+            applyParameter(id, value);
         }
     }
+}
+
+void JunoDSPEngine::applyParameter(ParamId id, float value) {
+    appliedParams_[static_cast<std::size_t>(id)] = value;
+    if (id == ParamId::ChorusMode) {
+        chorus_.setMode(BBDChorus::modeFromIndex(static_cast<int>(value)));
+    }
+    voices_.setParam(id, value);
+}
+
+bool JunoDSPEngine::renderBlock(float *L, float *R, int n,
+                                bool hasHostTime, std::uint64_t hostTimeNanos) {
+    jobFlushDenormals_ = flushDenormals_.load(std::memory_order_relaxed);
+    const DenormalGuard denormals(jobFlushDenormals_);
+    const std::int64_t blockStart = sampleTime_.load(std::memory_order_relaxed);
+    const std::int64_t blockEnd   = blockStart + n;
+    allocator_.setPolicy(static_cast<VoiceAllocator::Policy>(
+        voicePolicy_.load(std::memory_order_relaxed)));
+    applyStoredParameters();
+    collectEvents(blockStart, hasHostTime, hostTimeNanos);
 
     if (useGPU_
 #if defined(__APPLE__) && defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE
@@ -121,41 +339,151 @@ void JunoDSPEngine::renderAudio(float *L, float *R, int n) {
 #endif
     ) {
 #if defined(__APPLE__) && defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE
+        // The GPU renders whole buffers, so events land on the block start.
+        std::size_t due = 0;
+        while (due < pending_.size() && pending_[due].time < blockEnd) {
+            applyEvent(pending_[due++]);
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(due));
+
         // Collect voice state for GPU without heap allocations on the audio thread.
-        if (gpuVoiceCache_ && gpuVoiceCache_->size() >= voices_.size()) {
-            for (std::size_t i = 0; i < voices_.size(); ++i) {
-                const auto &v = voices_[i];
-                VoiceGPUParams &vp = (*gpuVoiceCache_)[i];
-                vp.frequency  = v->frequency_;
-                vp.velocity   = v->velocity_;
-                vp.envelope   = v->envelopeLevel();
-                vp.phase[0]   = v->phase();
+        if (gpuVoiceCache_ &&
+            gpuVoiceCache_->size() >= static_cast<std::size_t>(voices_.size())) {
+            for (int i = 0; i < voices_.size(); ++i) {
+                VoiceGPUParams &vp = (*gpuVoiceCache_)[static_cast<std::size_t>(i)];
+                vp.frequency  = voices_.frequency(i);
+                vp.velocity   = voices_.velocity(i);
+                vp.envelope   = voices_.envelopeLevel(i);
+                vp.phase[0]   = voices_.phase(i);
                 vp.phase[1]   = 0.0f;
                 vp.phase[2]   = 0.0f;
-                vp.pulseWidth = v->pulseWidth();
-                vp.active     = v->isActive() ? 1u : 0u;
+                vp.pulseWidth = voices_.pulseWidth();
+                vp.active     = voices_.isActive(i) ? 1u : 0u;
             }
             gpu_->updateVoices(*gpuVoiceCache_);
         }
-        gpu_->render(L, R, n);
-        for (auto &voice : voices_) {
-            voice->advanceState(n);
+        const bool sounding = voices_.anyActive();
+        if (sounding) {
+            gpu_->render(L, R, n);
+            voices_.advanceState(n);
+        } else {
+            std::fill(L, L + n, 0.0f);
+            std::fill(R, R + n, 0.0f);
         }
-        return;
+        reclaimVoices();
+        sampleTime_.store(blockEnd, std::memory_order_release);
+        return !sounding;
 #endif
     }
 
-    // CPU path
+    // Split the callback at event boundaries so each event takes effect on
+    // its own frame.
+    bool audible = false;
+    int pos = 0;
+    while (pos < n) {
+        std::size_t due = 0;
+        while (due < pending_.size() && pending_[due].time <= blockStart + pos) {
+            applyEvent(pending_[due++]);
+        }
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(due));
+
+        int end = n;
+        if (!pending_.empty() && pending_.front().time < blockEnd) {
+            end = static_cast<int>(pending_.front().time - blockStart);
+        }
+        audible |= renderVoices(L + pos, R + pos, end - pos);
+        reclaimVoices();
+        pos = end;
+    }
+
+    sampleTime_.store(blockEnd, std::memory_order_release);
+    return !audible;
+}
+
+int JunoDSPEngine::busTailFrames() const {
+    if (voices_.perVoiceChorus() || chorus_.mode() == BBDChorus::Mode::Off) {
+        return 0;
+    }
+    return chorus_.tailFrames();
+}
+
+bool JunoDSPEngine::renderVoices(float *L, float *R, int n) {
+    // CPU path: render the voice bank group by group into per-voice scratch,
+    // then sum the voices in a fixed order. With the shared chorus bus the
+    // voices are mono and the chorus runs once on their sum.
     std::fill(L, L + n, 0.0f);
     std::fill(R, R + n, 0.0f);
 
-    for (auto &voice : voices_) {
-        for (int i = 0; i < n; ++i) {
-            float l = 0.0f;
-            float r = 0.0f;
-            voice->process(l, r);
-            L[i] += l;
-            R[i] += r;
+    // Idle: no voice to walk and no chorus tail to play out.
+    const int tail = busTailFrames();
+    if (!voices_.anyActive() && quietFrames_ >= tail) {
+        quietFrames_ += n;
+        return false;
+    }
+
+    bool audible = false;
+
+    const bool perVoiceChorus = voices_.perVoiceChorus();
+    const std::size_t stride = static_cast<std::size_t>(blockFrames_) * 2;
+    const int groups = voices_.groupCount();
+    for (int offset = 0; offset < n; offset += blockFrames_) {
+        const int frames = std::min(blockFrames_, n - offset);
+
+        if (voices_.anyActive()) {
+            jobFrames_ = frames;
+            workers_.run(&JunoDSPEngine::renderGroupJob, this, groups);
+        } else {
+            std::fill(groupRendered_.begin(), groupRendered_.end(), 0u);
+        }
+
+        bool voiced = false;
+        for (unsigned mask : groupRendered_) voiced |= mask != 0u;
+        quietFrames_ = voiced ? 0 : quietFrames_ + frames;
+        if (!voiced && quietFrames_ - frames >= tail) {
+            continue;   // outputs already zeroed
+        }
+        audible = true;
+
+        float *outL = L + offset;
+        float *outR = R + offset;
+        float *mono = busScratch_.data();
+        if (!perVoiceChorus) {
+            std::fill(mono, mono + frames, 0.0f);
+        }
+
+        for (int v = 0; v < voices_.size(); ++v) {
+            const unsigned mask = groupRendered_[static_cast<std::size_t>(v / VoiceBank::kLanes)];
+            if (!(mask & (1u << (v % VoiceBank::kLanes)))) continue;
+            const float *vl = voiceScratch_.data() + static_cast<std::size_t>(v) * stride;
+            if (!perVoiceChorus) {
+                for (int i = 0; i < frames; ++i) {
+                    mono[i] += vl[i];
+                }
+                continue;
+            }
+            const float *vr = vl + blockFrames_;
+            for (int i = 0; i < frames; ++i) {
+                outL[i] += vl[i];
+                outR[i] += vr[i];
+            }
+        }
+
+        if (!perVoiceChorus) {
+            chorus_.processBlock(mono, outL, outR, frames);
         }
     }
+    return audible;
+}
+
+void JunoDSPEngine::renderGroupJob(void *engine, int group) {
+    auto *self = static_cast<JunoDSPEngine *>(engine);
+    // Workers follow the callback's setting; on the audio thread this
+    // nests inside renderBlock()'s guard and changes nothing.
+    const DenormalGuard denormals(self->jobFlushDenormals_);
+    const std::size_t stride = static_cast<std::size_t>(self->blockFrames_) * 2;
+    float *vl = self->voiceScratch_.data() +
+                static_cast<std::size_t>(group) * VoiceBank::kLanes * stride;
+    self->groupRendered_[static_cast<std::size_t>(group)] =
+        self->voices_.renderGroup(group, vl, vl + self->blockFrames_, stride,
+                                  self->jobFrames_);
 }
@@ -1,10 +1,16 @@
 #pragma once
-#include "JunoVoice.hpp"
+#include "VoiceBank.hpp"
+#include "VoiceAllocator.hpp"
+#include "LoadGovernor.hpp"
+#include "RenderThreadPool.hpp"
 #include "RCUParameterManager.hpp"
+#include "EventQueue.hpp"
+#include <array>
 #include <vector>
 #include <memory>
 #include <string>
 #include <atomic>
+#include <cstdint>
 
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
@@ -21,26 +27,173 @@ namespace Juno106 {
 
 class JunoDSPEngine {
 public:
+    // Where the BBD chorus sits. SharedBus matches the hardware: one stereo
+    // chorus after the voice sum. PerVoice gives every voice its own chorus.
+    enum class ChorusRouting {
+        SharedBus,
+        PerVoice
+    };
+
     bool initialize(int sampleRate, int bufferSize, int polyphony, bool useGPU);
+    // Takes effect on the next initialize().
+    void setChorusRouting(ChorusRouting routing) { chorusRouting_ = routing; }
+    // Number of extra threads that render voice groups alongside the audio
+    // thread; 0 keeps rendering single-threaded. The voice mix is summed in
+    // the same order either way, so output is bit-identical. Takes effect
+    // on the next initialize().
+    void setWorkerThreads(int count) { workerThreads_ = count < 0 ? 0 : count; }
+    // Runs the voice filters at 1, 2 or 4 times the sample rate to keep
+    // their saturation from aliasing, at the cost of oversamplingLatency()
+    // frames of delay. Takes effect on the next initialize().
+    void setOversampling(int factor) { oversampling_ = factor; }
+    float oversamplingLatency() const { return voices_.latencyFrames(); }
+    // Rendering runs under a DenormalGuard (FTZ/DAZ) unless this is turned
+    // off, which only makes sense for benchmarking. Worker threads follow
+    // the same setting.
+    void setFlushDenormals(bool enabled) {
+        flushDenormals_.store(enabled, std::memory_order_relaxed);
+    }
+    // How notes are assigned and which voice is stolen when all are busy.
+    // Safe from any thread; applies from the next rendered block.
+    void setVoicePolicy(VoiceAllocator::Policy policy) {
+        voicePolicy_.store(static_cast<int>(policy), std::memory_order_relaxed);
+    }
+    // Times every callback against its deadline and, as the load nears it,
+    // first switches the voices to VoiceBank::Quality::Eco and then lowers
+    // the voice limit one lane group at a time (a partly used group costs as
+    // much as a full one). Both come back with hysteresis once there is
+    // headroom; see LoadGovernor. Off by default so offline renders stay
+    // deterministic. Takes effect on the next initialize().
+    void setAdaptiveQuality(bool enabled, const LoadGovernor::Config &config = {}) {
+        adaptiveQuality_ = enabled;
+        governorConfig_ = config;
+    }
+    // Smoothed render time of recent callbacks over their deadline, and how
+    // many quality steps are currently shed. Both stay 0 while adaptive
+    // quality is off. Safe from any thread.
+    float renderLoad() const { return renderLoad_.load(std::memory_order_relaxed); }
+    int qualityLevel() const { return qualityLevel_.load(std::memory_order_relaxed); }
     void start();
     void stop();
 
+    // Control-thread API, safe to call from any number of threads. Notes go
+    // through the event queue and parameters through the RCU parameter store;
+    // the audio thread applies both at the start of the next rendered block,
+    // and nothing here touches render state directly.
     void noteOn(int midiNote, float velocity);
     void noteOff(int midiNote);
-
+    void setParameter(ParamId id, float value);
+    // Unknown ids are ignored.
     void setParameter(const std::string &id, float value);
     void loadPatch(const Juno106::JunoPatch &patch);
+    // Last value set for `id` through the immediate API. Wait-free; safe
+    // from any thread, including the audio thread.
+    float getParameter(const std::string &id, float defaultValue = 0.0f) const {
+        return params_.get(id, defaultValue);
+    }
+
+    // Sample-accurate variants. `sampleTime` is on the engine's sample clock
+    // (see currentSampleTime()); events in the past apply immediately.
+    void noteOnAt(int midiNote, float velocity, std::int64_t sampleTime);
+    void noteOffAt(int midiNote, std::int64_t sampleTime);
+    void setParameterAt(ParamId id, float value, std::int64_t sampleTime);
+    void setParameterAt(const std::string &id, float value, std::int64_t sampleTime);
+    // Queue a pre-built event, e.g. stamped with host time. Returns false if
+    // the event queue is full.
+    bool scheduleEvent(const EngineEvent &event);
 
-    void renderAudio(float *left, float *right, int numFrames);
+    // Future events dropped because kMaxPendingEvents were already waiting.
+    // Safe from any thread.
+    std::uint64_t droppedEvents() const {
+        return droppedEvents_.load(std::memory_order_relaxed);
+    }
+
+    // Sample time of the first frame of the next block to be rendered.
+    std::int64_t currentSampleTime() const {
+        return sampleTime_.load(std::memory_order_acquire);
+    }
+
+    // Events are applied at their exact frame inside the block. When the
+    // callback knows the host time of its first frame (same clock as
+    // EngineEvent::TimeBase::HostNanos), pass it to place host-stamped events.
+    //
+    // Returns true if the block is silent: no voice sounded and no effect
+    // tail was left, and both outputs were zero-filled. Callbacks can pass
+    // this on (e.g. AVAudioSourceNode's isSilence) and skip their own work.
+    bool renderAudio(float *left, float *right, int numFrames);
+    bool renderAudio(float *left, float *right, int numFrames, std::uint64_t hostTimeNanos);
 
 private:
-    std::vector<std::unique_ptr<JunoVoice>> voices_;
+    // Upper bound on frames rendered per voice pass; longer callbacks are
+    // split so the per-voice scratch stays cache-resident.
+    static constexpr int kMaxBlockFrames = 256;
+    // Future events held on the audio thread, sorted by time.
+    static constexpr int kMaxPendingEvents = 1024;
+
+    VoiceBank voices_;
+    VoiceAllocator allocator_;
+    std::atomic<int> voicePolicy_{static_cast<int>(VoiceAllocator::Policy::Oldest)};
+
+    bool adaptiveQuality_ = false;
+    LoadGovernor::Config governorConfig_;
+    LoadGovernor governor_;
+    std::atomic<float> renderLoad_{0.0f};
+    std::atomic<int> qualityLevel_{0};
+    // Per-voice scratch, laid out voice-major: [voice][L|R][blockFrames_].
+    std::vector<float> voiceScratch_;
+    std::vector<unsigned> groupRendered_;
+    std::vector<float> busScratch_;     // mono voice sum for the chorus bus
+    BBDChorus chorus_;
+    ChorusRouting chorusRouting_ = ChorusRouting::SharedBus;
+
+    RenderThreadPool workers_;
+    int  workerThreads_ = 0;
+    int  oversampling_  = 1;
+    int  jobFrames_     = 0;   // frames for the voice-group jobs in flight
+    bool jobFlushDenormals_ = true;   // flushDenormals_ for the current callback
+    // Frames since a voice last sounded; once past busTailFrames() the
+    // shared chorus has nothing left to play and is skipped.
+    std::int64_t quietFrames_ = 0;
+
+    EventQueue events_;
+    std::vector<EngineEvent> pending_;   // capacity reserved in initialize()
+    std::atomic<std::uint64_t> droppedEvents_{0};
+    std::atomic<std::int64_t> sampleTime_{0};
+
     RCUParameterManager params_;
+    // Last value applied per ParamId, from the store or a timestamped event.
+    std::array<float, static_cast<std::size_t>(ParamId::Count)> appliedParams_{};
+    // Bumped per ParamId after each store write. The audio thread re-applies
+    // only ids whose serial moved, so a write to one id cannot revert a
+    // timestamped change to another.
+    std::array<std::atomic<std::uint32_t>, static_cast<std::size_t>(ParamId::Count)> paramSerial_{};
+    std::array<std::uint32_t, static_cast<std::size_t>(ParamId::Count)> appliedSerial_{};
+    int  blockFrames_ = kMaxBlockFrames;
     int  sampleRate_ = 44100;
     int  bufferSize_ = 256;
     std::atomic<bool> running_{false};
+    std::atomic<bool> flushDenormals_{true};
     bool useGPU_     = false;
 
+    bool renderTimed(float *left, float *right, int numFrames,
+                     bool hasHostTime, std::uint64_t hostTimeNanos);
+    bool renderBlock(float *left, float *right, int numFrames,
+                     bool hasHostTime, std::uint64_t hostTimeNanos);
+    int  voiceLimitFor(int level) const;
+    void applyQualityLevel(int level);
+    bool renderVoices(float *left, float *right, int numFrames);
+    int  busTailFrames() const;
+    void collectEvents(std::int64_t blockStart, bool hasHostTime,
+                       std::uint64_t hostTimeNanos);
+    void applyEvent(const EngineEvent &event);
+    void startNote(int midiNote, float velocity);
+    void releaseNote(int midiNote);
+    void reclaimVoices();
+    void applyStoredParameters();
+    void applyParameter(ParamId id, float value);
+
+    static void renderGroupJob(void *engine, int group);
+
 #if defined(__APPLE__) && defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE
     std::unique_ptr<JunoRenderEngine> gpu_;
     std::unique_ptr<std::vector<VoiceGPUParams>> gpuVoiceCache_;
@@ -7,17 +7,41 @@ void JunoVoice::initialize(float sr) {
     filter_.configure(sr);
     chorus_.configure(sr);
     chorus_.setMode(BBDChorus::Mode::I);
+
+    smoothing_.configure(sr);
+    envelopeSteps_.build(sr);
+    attackStep_  = envelopeSteps_.step(attack_);
+    decayStep_   = envelopeSteps_.step(decay_);
+    releaseStep_ = envelopeSteps_.step(release_);
+    cutoff_.fill(1000.0f);
+    resonance_.fill(0.1f);
+    pwm_.fill(pwmDepth_);
+    subLevel_.fill(0.0f);
+    updateFilterCoefficients();
+    landRamps();
+    smoothingFrame_ = 0;
 }
 
 void JunoVoice::noteOn(int midiNote, float vel) {
     active_   = true;
     velocity_ = vel;
     midiNote_ = midiNote;
-    frequency_ = 440.0f * std::pow(2.0f, (static_cast<float>(midiNote) - 69.0f) / 12.0f);
+    frequency_ = Juno106::ParameterScaler::noteToHz(midiNote);
     envLevel_  = 0.0f;
     envTarget_ = 1.0f;
+    envStep_   = attackStep_;
+    envStage_  = EnvelopeStage::Attack;
     phase_     = 0.0f;
     subPhase_  = 0.0f;
+
+    // A new note starts on the current settings rather than mid-ramp. Settled
+    // coefficients are already current, so only a cut-short ramp recomputes.
+    const bool cutoffMoved = cutoff_.snap(0);
+    const bool resonanceMoved = resonance_.snap(0);
+    pwm_.snap(0);
+    subLevel_.snap(0);
+    if (cutoffMoved || resonanceMoved) updateFilterCoefficients();
+    landRamps();
 }
 
 void JunoVoice::noteOff(int midiNote) {
@@ -25,8 +49,10 @@ void JunoVoice::noteOff(int midiNote) {
         return;
     }
 
-    // Let envelope decay
+    // Release from wherever the envelope is.
     envTarget_ = 0.0f;
+    envStep_   = releaseStep_;
+    envStage_  = EnvelopeStage::Release;
 }
 
 bool JunoVoice::isActive() const {
@@ -35,35 +61,106 @@ bool JunoVoice::isActive() const {
 
 void JunoVoice::setParam(const std::string &id, float v) {
     if (id == "cutoff") {
-        cutoff_ = v;
+        cutoff_.setTarget(0, v, smoothing_.cutoff);
     } else if (id == "resonance") {
-        resonance_ = v;
+        resonance_.setTarget(0, v, smoothing_.resonance);
     } else if (id == "attack") {
-        attack_ = std::max(0.0005f, v);
+        attack_     = std::max(0.0005f, v);
+        attackStep_ = envelopeSteps_.step(attack_);
+        refreshEnvelopeSegment();
+    } else if (id == "decay") {
+        decay_     = std::max(0.0005f, v);
+        decayStep_ = envelopeSteps_.step(decay_);
+        refreshEnvelopeSegment();
+    } else if (id == "sustain") {
+        sustain_ = std::clamp(v, 0.0f, 1.0f);
+        refreshEnvelopeSegment();
     } else if (id == "release") {
-        release_ = std::max(0.0005f, v);
+        release_     = std::max(0.0005f, v);
+        releaseStep_ = envelopeSteps_.step(release_);
+        refreshEnvelopeSegment();
     } else if (id == "pwmDepth") {
         pwmDepth_ = v;
+        pwm_.setTarget(0, v, smoothing_.pwmDepth);
     } else if (id == "subLevel") {
-        subLevel_ = v;
+        subLevel_.setTarget(0, v, smoothing_.subLevel);
+    }
+}
+
+void JunoVoice::refreshEnvelopeSegment() {
+    if (envStage_ == EnvelopeStage::Attack) {
+        envStep_ = attackStep_;
+    } else if (envStage_ == EnvelopeStage::Decay) {
+        envTarget_ = sustain_;
+        envStep_   = decayStep_;
+    } else if (envStage_ == EnvelopeStage::Release) {
+        envStep_ = releaseStep_;
+    }
+}
+
+void JunoVoice::updateFilterCoefficients() {
+    vcfGain_     = NonlinearVCF::stageGain(cutoff_.value[0], sampleRate_);
+    vcfFeedback_ = NonlinearVCF::feedbackGain(resonance_.value[0]);
+}
+
+void JunoVoice::advanceSmoothing() {
+    if (cutoff_.advance(smoothing_.cutoff)) {
+        vcfGain_ = NonlinearVCF::stageGain(cutoff_.value[0], sampleRate_);
+    }
+    if (resonance_.advance(smoothing_.resonance)) {
+        vcfFeedback_ = NonlinearVCF::feedbackGain(resonance_.value[0]);
     }
+    pwm_.advance(smoothing_.pwmDepth);
+    subLevel_.advance(smoothing_.subLevel);
+}
+
+// Sub-block boundary: restart the interpolation from the coefficients the
+// last one ended on and spread the next ramp step over kSmoothingFrames.
+void JunoVoice::beginSubBlock() {
+    constexpr float invLen = 1.0f / static_cast<float>(kSmoothingFrames);
+    gainNow_ = vcfGain_;
+    fbNow_   = vcfFeedback_;
+    pwmNow_  = VoiceSmoothing::clampPulseWidth(pwm_.value[0]);
+    subNow_  = subLevel_.value[0];
+    advanceSmoothing();
+    dGain_ = (vcfGain_ - gainNow_) * invLen;
+    dFb_   = (vcfFeedback_ - fbNow_) * invLen;
+    dPwm_  = (VoiceSmoothing::clampPulseWidth(pwm_.value[0]) - pwmNow_) * invLen;
+    dSub_  = (subLevel_.value[0] - subNow_) * invLen;
+}
+
+void JunoVoice::landRamps() {
+    gainNow_ = vcfGain_;
+    fbNow_   = vcfFeedback_;
+    pwmNow_  = VoiceSmoothing::clampPulseWidth(pwm_.value[0]);
+    subNow_  = subLevel_.value[0];
+    dGain_ = dFb_ = dPwm_ = dSub_ = 0.0f;
 }
 
 void JunoVoice::process(float &L, float &R) {
     if (!stepEnvelopeAndPhase()) return;
 
-    float pwm = std::clamp(pwmDepth_, 0.05f, 0.95f);
+    if (smoothingFrame_ == 0) beginSubBlock();
+    smoothingFrame_ = (smoothingFrame_ + 1) % kSmoothingFrames;
+    gainNow_ += dGain_;
+    fbNow_   += dFb_;
+    pwmNow_  += dPwm_;
+    subNow_  += dSub_;
 
-    float osc = (phase_ < pwm) ? -1.0f + (phase_ / pwm) * 2.0f
-                               :  1.0f - ((phase_ - pwm) / (1.0f - pwm)) * 2.0f;
+    float pwm = VoiceSmoothing::clampPulseWidth(pwm_.value[0]);
 
-    // Sub oscillator at half frequency (square-ish)
-    float sub = (subPhase_ < 0.5f ? 1.0f : -1.0f) * subLevel_;
+    // Band-limited saw + pulse, and a square sub at half frequency
+    const float invSr  = 1.0f / std::max(sampleRate_, 1.0f);
+    const float inc    = frequency_ * invSr;
+    const float subInc = (frequency_ * 0.5f) * invSr;
+    float osc = polyblep::sawPulse(phase_, pwm, inc, polyblep::inverseIncrement(inc));
+    float sub = polyblep::sub(subPhase_, subInc, polyblep::inverseIncrement(subInc)) *
+                subLevel_.value[0];
 
     float mixed = osc + sub;
 
     // Filter
-    float filtered = filter_.process(mixed, cutoff_, resonance_);
+    float filtered = filter_.process(mixed, cutoff_.value[0], resonance_.value[0]);
 
     // Chorus to stereo
     float outL = 0.0f;
@@ -74,7 +171,121 @@ void JunoVoice::process(float &L, float &R) {
     R += outR * envLevel_ * velocity_;
 }
 
+bool JunoVoice::renderBlock(float *L, float *R, int n) {
+    if (n <= 0) return active_;
+    if (!active_) {
+        // Idle voices do not ramp, but the sub-block clock keeps time.
+        smoothingFrame_ = (smoothingFrame_ + n) % kSmoothingFrames;
+        std::fill(L, L + n, 0.0f);
+        std::fill(R, R + n, 0.0f);
+        return false;
+    }
+
+    // Everything below is constant for the block, so compute it once.
+    const float invSr       = 1.0f / std::max(sampleRate_, 1.0f);
+    const float phaseInc    = frequency_ * invSr;
+    const float subInc      = (frequency_ * 0.5f) * invSr;
+    const float invInc      = polyblep::inverseIncrement(phaseInc);
+    const float invSubInc   = polyblep::inverseIncrement(subInc);
+    const float sustain     = sustain_;
+    const float decayStep   = decayStep_;
+
+    float env       = envLevel_;
+    float envTarget = envTarget_;
+    float envStep   = envStep_;
+    float envStage  = envStage_;
+    float phase     = phase_;
+    float subPhase  = subPhase_;
+
+    // Work through the block in smoothing sub-blocks: the parameter ramps
+    // advance once per sub-block and their stage-ready values are
+    // interpolated across it. The sub-block clock runs on from the last call.
+    int rendered = 0;
+    bool alive = true;
+    for (int start = 0; start < n && alive;) {
+        if (smoothingFrame_ == 0) beginSubBlock();
+        const int end = std::min(start + kSmoothingFrames - smoothingFrame_, n);
+
+        float pwm      = pwmNow_;
+        float subLevel = subNow_;
+        const float dPwm = dPwm_;
+        const float dSub = dSub_;
+
+        // Pass 1: envelope + oscillators. The mono oscillator mix goes to L
+        // and the per-sample envelope level to R, so no extra scratch is
+        // needed.
+        int i = start;
+        for (; i < end; ++i) {
+            pwm      += dPwm;
+            subLevel += dSub;
+
+            env = stepEnvelope(env, envTarget, envStep, envStage, sustain, decayStep);
+
+            if (env * velocity_ < kRetireLevel && envTarget == 0.0f) {
+                active_   = false;
+                midiNote_ = -1;
+                alive     = false;
+                break;
+            }
+
+            phase += phaseInc;
+            if (phase >= 1.0f) phase -= 1.0f;
+
+            subPhase += subInc;
+            if (subPhase >= 1.0f) subPhase -= 1.0f;
+
+            const float osc = polyblep::sawPulse(phase, pwm, phaseInc, invInc);
+            const float sub = polyblep::sub(subPhase, subInc, invSubInc) * subLevel;
+
+            L[i] = osc + sub;
+            R[i] = env;
+        }
+
+        // Pass 2: filter the segment with the ramped coefficients.
+        filter_.processBlockRamped(L + start, i - start, gainNow_, dGain_, fbNow_, dFb_);
+        pwmNow_ = pwm;
+        subNow_ = subLevel;
+        smoothingFrame_ = (smoothingFrame_ + (i - start)) % kSmoothingFrames;
+
+        // Pass 3: chorus to stereo and apply the amplitude envelope.
+        for (int j = start; j < i; ++j) {
+            const float envAtSample = R[j];
+            float outL = 0.0f;
+            float outR = 0.0f;
+            chorus_.process(L[j], outL, outR);
+            L[j] = outL * envAtSample * velocity_;
+            R[j] = outR * envAtSample * velocity_;
+        }
+        rendered = i;
+        start = end;
+    }
+
+    envLevel_  = env;
+    envTarget_ = envTarget;
+    envStep_   = envStep;
+    envStage_  = envStage;
+    phase_     = phase;
+    subPhase_  = subPhase;
+
+    if (rendered < n) {
+        smoothingFrame_ = (smoothingFrame_ + (n - rendered)) % kSmoothingFrames;
+        std::fill(L + rendered, L + n, 0.0f);
+        std::fill(R + rendered, R + n, 0.0f);
+    }
+    return true;
+}
+
 void JunoVoice::advanceState(int numFrames) {
+    // The GPU path renders whole blocks at fixed settings; land the ramps so
+    // the CPU state follows what it heard.
+    cutoff_.snap(0);
+    resonance_.snap(0);
+    pwm_.snap(0);
+    subLevel_.snap(0);
+    updateFilterCoefficients();
+    landRamps();
+    smoothingFrame_ = (smoothingFrame_ + numFrames) % kSmoothingFrames;
+
     for (int i = 0; i < numFrames; ++i) {
         if (!stepEnvelopeAndPhase()) {
             return;
@@ -87,23 +298,15 @@ bool JunoVoice::stepEnvelopeAndPhase() {
         return false;
     }
 
-    // Envelope follower (simple one-pole towards envTarget)
-    float envRate = (envTarget_ > envLevel_) ? attack_ : release_;
-    if (envRate <= 0.0f || sampleRate_ <= 0.0f) {
-        envLevel_ = envTarget_;
-    } else {
-        float step = 1.0f - std::exp(-1.0f / (envRate * sampleRate_));
-        step = std::clamp(step, 0.0f, 1.0f);
-        envLevel_ += (envTarget_ - envLevel_) * step;
-    }
+    envLevel_ = stepEnvelope(envLevel_, envTarget_, envStep_, envStage_, sustain_, decayStep_);
 
-    if (envLevel_ < 1e-4f && envTarget_ == 0.0f) {
+    if (envLevel_ * velocity_ < kRetireLevel && envTarget_ == 0.0f) {
         active_ = false;
         midiNote_ = -1;
         return false;
     }
 
-    // Simple sawtooth oscillator with PWM-like modulation
+    // Advance the oscillator phases
     phase_ += frequency_ / std::max(sampleRate_, 1.0f);
     if (phase_ >= 1.0f) phase_ -= 1.0f;
 
@@ -1,6 +1,10 @@
 #pragma once
 #include "../dsp/NonlinearVCF.hpp"
 #include "../dsp/BBDChorus.hpp"
+#include "PolyBLEP.hpp"
+#include "EnvelopeSegments.hpp"
+#include "ParameterSmoother.hpp"
+#include "PatchCurves.hpp"
 #include <cmath>
 #include <string>
 
@@ -11,9 +15,21 @@ public:
     void noteOff(int midiNote);
     void advanceState(int numFrames);
     void setParam(const std::string &id, float value);
+    // Per-sample reference path. Parameter ramps advance every
+    // kSmoothingFrames calls and hold in between.
     void process(float &left, float &right);
+
+    // Render `numFrames` samples of this voice into `left`/`right`,
+    // overwriting their contents. Voice state is held in locals for the
+    // whole block. Returns false (and writes silence) if the voice was
+    // already inactive when the block started.
+    bool renderBlock(float *left, float *right, int numFrames);
     bool isActive() const;
 
+    // The voice is retired once envelope * velocity falls below this
+    // (-80 dB), matching VoiceBank.
+    static constexpr float kRetireLevel = 1e-4f;
+
     // Exposed for GPU bridge / monitoring
     float frequency_ = 0.0f;
     float velocity_  = 0.0f;
@@ -27,20 +43,46 @@ private:
     float sampleRate_ = 44100.0f;
     float phase_      = 0.0f;
     float envLevel_   = 0.0f;
-    float envTarget_  = 0.0f;
+    float envTarget_  = 0.0f;   // current segment (EnvelopeSegments.hpp)
+    float envStep_    = 1.0f;
+    float envStage_   = EnvelopeStage::Idle;
     bool  active_     = false;
     int   midiNote_   = -1;
 
     float attack_     = 0.01f;
+    float decay_      = 0.3f;
+    float sustain_    = 1.0f;
     float release_    = 0.5f;
-    float cutoff_     = 1000.0f;
-    float resonance_  = 0.1f;
-    float subLevel_   = 0.0f;
     float pwmDepth_   = 0.5f;
     float subPhase_   = 0.0f;
 
+    float attackStep_  = 1.0f;
+    float decayStep_   = 1.0f;
+    float releaseStep_ = 1.0f;
+
+    // Smoothed parameters, mirroring one VoiceBank lane.
+    VoiceSmoothing   smoothing_;
+    EnvelopeSteps    envelopeSteps_;
+    SmoothedLanes<1> cutoff_;
+    SmoothedLanes<1> resonance_;
+    SmoothedLanes<1> pwm_;
+    SmoothedLanes<1> subLevel_;
+    float vcfGain_       = 0.0f;   // stageGain() of cutoff_
+    float vcfFeedback_   = 0.0f;   // feedbackGain() of resonance_
+    // Coefficients interpolated across the current sub-block, their
+    // per-sample steps and the position in it. Kept across calls so ramps
+    // advance every kSmoothingFrames samples however the blocks are split.
+    float gainNow_ = 0.0f, fbNow_ = 0.0f, pwmNow_ = 0.0f, subNow_ = 0.0f;
+    float dGain_   = 0.0f, dFb_   = 0.0f, dPwm_   = 0.0f, dSub_   = 0.0f;
+    int   smoothingFrame_ = 0;
+
     NonlinearVCF filter_;
     BBDChorus    chorus_;
 
     bool stepEnvelopeAndPhase();
+    void advanceSmoothing();
+    void beginSubBlock();
+    void landRamps();
+    void updateFilterCoefficients();
+    void refreshEnvelopeSegment();
 };
@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+
+// Steps render quality down as the audio callback nears its deadline and
+// back up once there is headroom again.
+//
+// The caller times each callback and reports it with update(): render
+// seconds against the seconds of audio produced, so load 1.0 means the
+// callback used its whole deadline. A smoothed load above degradeLoad for
+// degradeBlocks callbacks in a row (or a single callback above panicLoad)
+// moves one level down; only a long run of callbacks below restoreLoad
+// moves one level back up. The gap between the two thresholds and the much
+// longer restore run keep a load that sits near a threshold from flapping
+// between levels. Level 0 is full quality; what each level turns off is up
+// to the caller.
+class LoadGovernor {
+public:
+    struct Config {
+        float degradeLoad   = 0.75f;
+        float restoreLoad   = 0.45f;
+        float panicLoad     = 0.95f;   // one callback this slow degrades at once
+        float smoothing     = 0.25f;   // weight of the newest callback in the average
+        int   degradeBlocks = 3;
+        int   restoreBlocks = 250;     // about 1.5 s of 256-frame callbacks at 44.1 kHz
+    };
+
+    void configure(const Config &config, int maxLevel) {
+        config_   = config;
+        maxLevel_ = std::max(maxLevel, 0);
+        reset();
+    }
+
+    void reset() {
+        level_     = 0;
+        load_      = 0.0f;
+        lastLoad_  = 0.0f;
+        overRun_   = 0;
+        underRun_  = 0;
+    }
+
+    // Returns true if the level changed.
+    bool update(double renderSeconds, double deadlineSeconds) {
+        if (deadlineSeconds <= 0.0) return false;
+        lastLoad_ = static_cast<float>(renderSeconds / deadlineSeconds);
+        load_ += (lastLoad_ - load_) * config_.smoothing;
+
+        overRun_  = (load_ > config_.degradeLoad) ? overRun_ + 1 : 0;
+        underRun_ = (load_ < config_.restoreLoad) ? underRun_ + 1 : 0;
+
+        const bool degrade = overRun_ >= config_.degradeBlocks ||
+                             lastLoad_ > config_.panicLoad;
+        if (degrade && level_ < maxLevel_) {
+            ++level_;
+            // Judge the next level on its own callbacks.
+            overRun_ = underRun_ = 0;
+            load_ = std::min(load_, config_.degradeLoad);
+            return true;
+        }
+        if (underRun_ >= config_.restoreBlocks && level_ > 0) {
+            --level_;
+            overRun_ = underRun_ = 0;
+            return true;
+        }
+        return false;
+    }
+
+    int   level() const { return level_; }
+    int   maxLevel() const { return maxLevel_; }
+    float load() const { return load_; }
+    float lastLoad() const { return lastLoad_; }
+
+private:
+    Config config_;
+    int    maxLevel_ = 0;
+    int    level_    = 0;
+    float  load_     = 0.0f;
+    float  lastLoad_ = 0.0f;
+    int    overRun_  = 0;
+    int    underRun_ = 0;
+};
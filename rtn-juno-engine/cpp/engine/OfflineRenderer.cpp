@@ -0,0 +1,382 @@
+#include "OfflineRenderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::vector<std::uint8_t> readBinaryFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>());
+}
+
+// Cursor over a byte buffer that throws instead of reading past the end.
+class ByteReader {
+public:
+    ByteReader(const std::vector<std::uint8_t> &data, std::size_t begin, std::size_t end)
+        : data_(data), pos_(begin), end_(end) {}
+
+    bool atEnd() const { return pos_ >= end_; }
+    std::size_t position() const { return pos_; }
+
+    std::uint8_t u8() {
+        if (pos_ >= end_) throw std::runtime_error("Truncated MIDI data");
+        return data_[pos_++];
+    }
+    std::uint16_t u16() {
+        const std::uint16_t hi = u8();
+        return static_cast<std::uint16_t>((hi << 8) | u8());
+    }
+    std::uint32_t u32() {
+        const std::uint32_t hi = u16();
+        return (hi << 16) | u16();
+    }
+    std::uint32_t varLen() {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const std::uint8_t b = u8();
+            value = (value << 7) | (b & 0x7F);
+            if (!(b & 0x80)) return value;
+        }
+        throw std::runtime_error("Invalid MIDI variable-length quantity");
+    }
+    void skip(std::size_t n) {
+        if (n > end_ - pos_) throw std::runtime_error("Truncated MIDI data");
+        pos_ += n;
+    }
+
+private:
+    const std::vector<std::uint8_t> &data_;
+    std::size_t pos_;
+    std::size_t end_;
+};
+
+struct TickEvent {
+    std::uint64_t tick = 0;
+    bool          isTempo = false;
+    std::uint32_t tempo = 500000;  // microseconds per quarter note
+    OfflineEvent  event;
+};
+
+void putU16(std::ofstream &out, std::uint16_t v) {
+    const char b[2] = {static_cast<char>(v & 0xFF), static_cast<char>(v >> 8)};
+    out.write(b, 2);
+}
+
+void putU32(std::ofstream &out, std::uint32_t v) {
+    const char b[4] = {static_cast<char>(v & 0xFF), static_cast<char>((v >> 8) & 0xFF),
+                       static_cast<char>((v >> 16) & 0xFF), static_cast<char>(v >> 24)};
+    out.write(b, 4);
+}
+
+void putFloat(std::ofstream &out, float f) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &f, sizeof(bits));
+    putU32(out, bits);
+}
+
+} // namespace
+
+std::vector<OfflineEvent> OfflineRenderer::readMidiFile(const std::string &path) {
+    return parseMidi(readBinaryFile(path));
+}
+
+std::vector<OfflineEvent> OfflineRenderer::parseMidi(const std::vector<std::uint8_t> &data) {
+    ByteReader header(data, 0, data.size());
+    if (header.u32() != 0x4D546864u) { // "MThd"
+        throw std::runtime_error("Not a Standard MIDI File");
+    }
+    const std::uint32_t headerLength = header.u32();
+    if (headerLength < 6) {
+        throw std::runtime_error("Invalid MIDI header length");
+    }
+    const std::uint16_t format   = header.u16();
+    const std::uint16_t numTracks = header.u16();
+    const std::uint16_t division = header.u16();
+    header.skip(headerLength - 6);
+
+    if (format > 1) {
+        throw std::runtime_error("Unsupported MIDI file format (only 0 and 1)");
+    }
+
+    // SMPTE division gives a fixed tick length; PPQ depends on the tempo.
+    double smpteSecondsPerTick = 0.0;
+    int ticksPerQuarter = 0;
+    if (division & 0x8000) {
+        const int fps = -static_cast<int>(static_cast<std::int8_t>(division >> 8));
+        const int ticksPerFrame = division & 0xFF;
+        if (fps <= 0 || ticksPerFrame <= 0) {
+            throw std::runtime_error("Invalid SMPTE division in MIDI file");
+        }
+        smpteSecondsPerTick = 1.0 / (static_cast<double>(fps) * ticksPerFrame);
+    } else {
+        ticksPerQuarter = division;
+        if (ticksPerQuarter == 0) {
+            throw std::runtime_error("Invalid MIDI division");
+        }
+    }
+
+    std::vector<TickEvent> tickEvents;
+    std::size_t pos = header.position();
+    for (int t = 0; t < numTracks && pos < data.size(); ++t) {
+        ByteReader chunk(data, pos, data.size());
+        const std::uint32_t id = chunk.u32();
+        const std::uint32_t length = chunk.u32();
+        const std::size_t begin = chunk.position();
+        if (length > data.size() - begin) {
+            throw std::runtime_error("Truncated MIDI track");
+        }
+        pos = begin + length;
+        if (id != 0x4D54726Bu) { // "MTrk"; skip unknown chunks
+            --t;
+            continue;
+        }
+
+        ByteReader track(data, begin, begin + length);
+        std::uint64_t tick = 0;
+        std::uint8_t status = 0;
+        while (!track.atEnd()) {
+            tick += track.varLen();
+            std::uint8_t b = track.u8();
+
+            if (b == 0xFF) {
+                const std::uint8_t type = track.u8();
+                const std::uint32_t len = track.varLen();
+                if (type == 0x51 && len == 3) {
+                    TickEvent te;
+                    te.tick = tick;
+                    te.isTempo = true;
+                    te.tempo = (static_cast<std::uint32_t>(track.u8()) << 16);
+                    te.tempo |= (static_cast<std::uint32_t>(track.u8()) << 8);
+                    te.tempo |= track.u8();
+                    tickEvents.push_back(te);
+                } else {
+                    track.skip(len);
+                    if (type == 0x2F) break; // end of track
+                }
+                continue;
+            }
+            if (b == 0xF0 || b == 0xF7) {
+                track.skip(track.varLen());
+                continue;
+            }
+
+            std::uint8_t data1 = 0;
+            if (b & 0x80) {
+                status = b;
+                data1 = track.u8();
+            } else {
+                if (status == 0) throw std::runtime_error("MIDI running status without status byte");
+                data1 = b; // running status
+            }
+
+            const std::uint8_t kind = status & 0xF0;
+            const bool twoDataBytes = kind != 0xC0 && kind != 0xD0;
+            const std::uint8_t data2 = twoDataBytes ? track.u8() : 0;
+
+            if (kind == 0x90 || kind == 0x80) {
+                TickEvent te;
+                te.tick = tick;
+                te.event.note = data1 & 0x7F;
+                if (kind == 0x90 && data2 > 0) {
+                    te.event.type = OfflineEvent::Type::NoteOn;
+                    te.event.value = static_cast<float>(data2) / 127.0f;
+                } else {
+                    te.event.type = OfflineEvent::Type::NoteOff;
+                }
+                tickEvents.push_back(te);
+            }
+        }
+    }
+
+    // Tempo changes apply to every track, so convert on the merged timeline.
+    std::stable_sort(tickEvents.begin(), tickEvents.end(),
+                     [](const TickEvent &a, const TickEvent &b) {
+                         if (a.tick != b.tick) return a.tick < b.tick;
+                         return a.isTempo && !b.isTempo;
+                     });
+
+    std::vector<OfflineEvent> events;
+    events.reserve(tickEvents.size());
+    double seconds = 0.0;
+    std::uint64_t lastTick = 0;
+    double secondsPerTick = smpteSecondsPerTick > 0.0
+                          ? smpteSecondsPerTick
+                          : 0.5 / ticksPerQuarter;
+    for (const auto &te : tickEvents) {
+        seconds += static_cast<double>(te.tick - lastTick) * secondsPerTick;
+        lastTick = te.tick;
+        if (te.isTempo) {
+            if (smpteSecondsPerTick == 0.0) {
+                secondsPerTick = static_cast<double>(te.tempo) * 1e-6 / ticksPerQuarter;
+            }
+            continue;
+        }
+        OfflineEvent e = te.event;
+        e.time = seconds;
+        events.push_back(e);
+    }
+    return events;
+}
+
+std::vector<OfflineEvent> OfflineRenderer::readEventList(const std::string &path) {
+    const auto bytes = readBinaryFile(path);
+    return parseEventList(std::string(bytes.begin(), bytes.end()));
+}
+
+std::vector<OfflineEvent> OfflineRenderer::parseEventList(const std::string &text) {
+    std::vector<OfflineEvent> events;
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream fields(line);
+        std::string kind;
+        OfflineEvent e;
+        if (!(fields >> e.time)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            throw std::runtime_error("Bad event time on line " + std::to_string(lineNumber));
+        }
+        fields >> kind;
+
+        bool ok = false;
+        if (kind == "on") {
+            e.type = OfflineEvent::Type::NoteOn;
+            ok = static_cast<bool>(fields >> e.note >> e.value);
+        } else if (kind == "off") {
+            e.type = OfflineEvent::Type::NoteOff;
+            ok = static_cast<bool>(fields >> e.note);
+        } else if (kind == "param") {
+            e.type = OfflineEvent::Type::Parameter;
+            ok = static_cast<bool>(fields >> e.param >> e.value);
+        }
+        if (!ok || e.time < 0.0) {
+            throw std::runtime_error("Bad event on line " + std::to_string(lineNumber));
+        }
+        events.push_back(e);
+    }
+    return events;
+}
+
+OfflineRenderResult OfflineRenderer::render(JunoDSPEngine &engine,
+                                            std::vector<OfflineEvent> events,
+                                            int sampleRate,
+                                            int blockSize,
+                                            double tailSeconds) {
+    if (sampleRate <= 0 || blockSize <= 0) {
+        throw std::runtime_error("Invalid offline render configuration");
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const OfflineEvent &a, const OfflineEvent &b) { return a.time < b.time; });
+
+    const double endTime = (events.empty() ? 0.0 : events.back().time) +
+                           std::max(tailSeconds, 0.0);
+    const auto totalFrames = static_cast<std::size_t>(std::ceil(endTime * sampleRate));
+    auto frameOf = [sampleRate](const OfflineEvent &e) {
+        return static_cast<std::size_t>(std::llround(e.time * sampleRate));
+    };
+
+    OfflineRenderResult result;
+    result.sampleRate = sampleRate;
+    result.left.assign(totalFrames, 0.0f);
+    result.right.assign(totalFrames, 0.0f);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::size_t next = 0;
+    std::size_t frame = 0;
+    while (frame < totalFrames) {
+        for (; next < events.size() && frameOf(events[next]) <= frame; ++next) {
+            const OfflineEvent &e = events[next];
+            switch (e.type) {
+                case OfflineEvent::Type::NoteOn:    engine.noteOn(e.note, e.value); break;
+                case OfflineEvent::Type::NoteOff:   engine.noteOff(e.note); break;
+                case OfflineEvent::Type::Parameter: engine.setParameter(e.param, e.value); break;
+            }
+        }
+
+        // Split the block at the next event so it lands on its exact sample.
+        std::size_t end = std::min(totalFrames, frame + static_cast<std::size_t>(blockSize));
+        if (next < events.size()) {
+            end = std::min(end, std::max(frameOf(events[next]), frame + 1));
+        }
+        engine.renderAudio(result.left.data() + frame, result.right.data() + frame,
+                           static_cast<int>(end - frame));
+        frame = end;
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void OfflineRenderer::writeWav(const std::string &path, const OfflineRenderResult &result) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+
+    const std::uint16_t channels = 2;
+    const std::uint16_t bitsPerSample = 32;
+    const std::uint32_t frames = static_cast<std::uint32_t>(result.left.size());
+    const std::uint32_t blockAlign = channels * bitsPerSample / 8;
+    const std::uint32_t dataBytes = frames * blockAlign;
+
+    out.write("RIFF", 4);
+    putU32(out, 4 + (8 + 18) + (8 + 4) + (8 + dataBytes));
+    out.write("WAVE", 4);
+
+    out.write("fmt ", 4);
+    putU32(out, 18);
+    putU16(out, 3); // WAVE_FORMAT_IEEE_FLOAT
+    putU16(out, channels);
+    putU32(out, static_cast<std::uint32_t>(result.sampleRate));
+    putU32(out, static_cast<std::uint32_t>(result.sampleRate) * blockAlign);
+    putU16(out, static_cast<std::uint16_t>(blockAlign));
+    putU16(out, bitsPerSample);
+    putU16(out, 0);
+
+    // Non-PCM formats carry a fact chunk with the frame count.
+    out.write("fact", 4);
+    putU32(out, 4);
+    putU32(out, frames);
+
+    out.write("data", 4);
+    putU32(out, dataBytes);
+    for (std::uint32_t i = 0; i < frames; ++i) {
+        putFloat(out, result.left[i]);
+        putFloat(out, result.right[i]);
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write WAV file: " + path);
+    }
+}
+
+void OfflineRenderer::writeRawFloat(const std::string &path, const OfflineRenderResult &result) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+    for (std::size_t i = 0; i < result.left.size(); ++i) {
+        putFloat(out, result.left[i]);
+        putFloat(out, result.right[i]);
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write raw float file: " + path);
+    }
+}
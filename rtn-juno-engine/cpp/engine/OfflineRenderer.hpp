@@ -0,0 +1,66 @@
+#pragma once
+#include "JunoDSPEngine.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A note or parameter change at an absolute time in an offline render.
+struct OfflineEvent {
+    enum class Type {
+        NoteOn,
+        NoteOff,
+        Parameter
+    };
+
+    double      time  = 0.0;      // seconds from the start of the render
+    Type        type  = Type::NoteOn;
+    int         note  = 0;
+    float       value = 0.0f;     // velocity (0..1) or parameter value
+    std::string param;            // parameter id for Type::Parameter
+};
+
+struct OfflineRenderResult {
+    std::vector<float> left;
+    std::vector<float> right;
+    int    sampleRate  = 0;
+    double wallSeconds = 0.0;
+
+    double audioSeconds() const {
+        return sampleRate > 0 ? static_cast<double>(left.size()) / sampleRate : 0.0;
+    }
+    double realtimeFactor() const {
+        return wallSeconds > 0.0 ? audioSeconds() / wallSeconds : 0.0;
+    }
+};
+
+// Non-realtime rendering on top of JunoDSPEngine: drives the engine from an
+// event list as fast as the CPU allows, with events applied at their exact
+// sample position. Readers and writers throw std::runtime_error on failure,
+// like Juno106::PatchParser.
+class OfflineRenderer {
+public:
+    // Standard MIDI File (format 0 or 1). Note-ons/offs on any channel are
+    // kept; tempo changes are honoured. Velocities are mapped to 0..1.
+    static std::vector<OfflineEvent> readMidiFile(const std::string &path);
+    static std::vector<OfflineEvent> parseMidi(const std::vector<std::uint8_t> &data);
+
+    // Plain-text event list, one event per line ('#' starts a comment):
+    //   <seconds> on <note> <velocity 0..1>
+    //   <seconds> off <note>
+    //   <seconds> param <id> <value>
+    static std::vector<OfflineEvent> readEventList(const std::string &path);
+    static std::vector<OfflineEvent> parseEventList(const std::string &text);
+
+    // Renders until `tailSeconds` after the last event. The engine must be
+    // initialized at `sampleRate`; blocks are at most `blockSize` frames.
+    static OfflineRenderResult render(JunoDSPEngine &engine,
+                                      std::vector<OfflineEvent> events,
+                                      int sampleRate,
+                                      int blockSize,
+                                      double tailSeconds);
+
+    // 32-bit float stereo WAV (WAVE_FORMAT_IEEE_FLOAT).
+    static void writeWav(const std::string &path, const OfflineRenderResult &result);
+    // Interleaved little-endian 32-bit float, no header.
+    static void writeRawFloat(const std::string &path, const OfflineRenderResult &result);
+};
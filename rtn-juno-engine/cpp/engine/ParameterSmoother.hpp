@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+// Per-voice parameter ramps, advanced once per sub-block instead of per
+// sample.
+//
+// Audio code renders in sub-blocks of kSmoothingFrames. At each sub-block
+// boundary every SmoothedLanes moves all of its lanes one step towards their
+// targets (a fixed-width lane loop), the caller turns the new values into
+// stage-ready coefficients (filter gain, feedback, pulse width...) and then
+// interpolates those coefficients linearly across the sub-block. A sweep
+// therefore costs one coefficient evaluation per sub-block per voice and
+// never steps audibly, and a settled parameter costs nothing extra.
+constexpr int kSmoothingFrames = 16;
+
+struct SmoothingSpec {
+    enum class Shape {
+        Linear,        // constant rate; reaches the target in rampSeconds
+        Exponential    // one-pole approach; ~98% of the way in rampSeconds
+    };
+
+    Shape shape       = Shape::Exponential;
+    float rampSeconds = 0.02f;
+
+    // Derived by configure().
+    float subBlocks   = 1.0f;  // linear: sub-blocks per full ramp
+    float coeff       = 1.0f;  // exponential: share of the distance per sub-block
+
+    void configure(float sampleRate) {
+        const float rampFrames = std::max(rampSeconds * sampleRate, 1.0f);
+        subBlocks = std::max(rampFrames / kSmoothingFrames, 1.0f);
+        coeff = std::min(1.0f, 1.0f - std::exp(-4.0f * kSmoothingFrames / rampFrames));
+    }
+};
+
+template <int Lanes>
+struct SmoothedLanes {
+    alignas(32) float value[Lanes]  = {};
+    alignas(32) float target[Lanes] = {};
+    alignas(32) float step[Lanes]   = {};   // linear ramps: distance per sub-block
+
+    // Jump every lane to `v`.
+    void fill(float v) {
+        std::fill(std::begin(value), std::end(value), v);
+        std::fill(std::begin(target), std::end(target), v);
+        std::fill(std::begin(step), std::end(step), 0.0f);
+    }
+
+    // Jump one lane to its target, e.g. when a voice (re)starts. Returns
+    // true if the value changed.
+    bool snap(int lane) {
+        const bool moved = value[lane] != target[lane];
+        value[lane] = target[lane];
+        step[lane]  = 0.0f;
+        return moved;
+    }
+
+    void setTarget(int lane, float v, const SmoothingSpec &spec) {
+        target[lane] = v;
+        step[lane]   = std::fabs(v - value[lane]) / spec.subBlocks;
+    }
+
+    void setTargetAll(float v, const SmoothingSpec &spec) {
+        for (int l = 0; l < Lanes; ++l) setTarget(l, v, spec);
+    }
+
+    // Moves every lane one sub-block along its ramp. Returns true if any
+    // lane's value changed.
+    bool advance(const SmoothingSpec &spec) {
+        bool moved = false;
+        if (spec.shape == SmoothingSpec::Shape::Linear) {
+            for (int l = 0; l < Lanes; ++l) {
+                const float d = target[l] - value[l];
+                value[l] = (std::fabs(d) <= step[l]) ? target[l]
+                                                     : value[l] + std::copysign(step[l], d);
+                moved |= d != 0.0f;
+            }
+        } else {
+            for (int l = 0; l < Lanes; ++l) {
+                const float d = target[l] - value[l];
+                // Snap once within 0.01% so ramps settle instead of creeping.
+                const bool close = std::fabs(d) <= 1e-4f * std::fabs(target[l]) + 1e-9f;
+                value[l] = close ? target[l] : value[l] + d * spec.coeff;
+                moved |= d != 0.0f;
+            }
+        }
+        return moved;
+    }
+};
+
+// Ramp settings for the voice parameters, shared by JunoVoice and VoiceBank
+// so the scalar reference and the lane path render identically.
+struct VoiceSmoothing {
+    SmoothingSpec cutoff    {SmoothingSpec::Shape::Exponential, 0.02f};
+    SmoothingSpec resonance {SmoothingSpec::Shape::Linear,      0.02f};
+    SmoothingSpec pwmDepth  {SmoothingSpec::Shape::Linear,      0.02f};
+    SmoothingSpec subLevel  {SmoothingSpec::Shape::Linear,      0.02f};
+
+    void configure(float sampleRate) {
+        cutoff.configure(sampleRate);
+        resonance.configure(sampleRate);
+        pwmDepth.configure(sampleRate);
+        subLevel.configure(sampleRate);
+    }
+
+    static float clampPulseWidth(float pwm) { return std::clamp(pwm, 0.05f, 0.95f); }
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include "ParameterScaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Slider curves JunoDSPEngine::loadPatch maps a patch through, generated at
+// compile time. The cutoff uses ParameterScaler::kCutoffHz.
+namespace PatchCurves {
+
+constexpr Juno106::CurveTable kAttackSeconds  = Juno106::exponentialCurve(0.0015, 1.5);
+// Decay and release share a slider range, as on the hardware.
+constexpr Juno106::CurveTable kReleaseSeconds = Juno106::exponentialCurve(0.0015, 5.97160756);   // 0.0015 * 10^3.6
+
+// Per-sample one-pole step that covers 1 - 1/e of the distance in `seconds`.
+inline float envelopeStep(float seconds, float sampleRate) {
+    if (seconds <= 0.0f || sampleRate <= 0.0f) {
+        return 1.0f;
+    }
+    float step = 1.0f - std::exp(-1.0f / (seconds * sampleRate));
+    return std::clamp(step, 0.0f, 1.0f);
+}
+
+} // namespace PatchCurves
+
+// envelopeStep() for every position of the attack and release curves at one
+// sample rate, rebuilt by the voices' initialize(). Times from a patch load
+// are then lookups; any other time is computed.
+class EnvelopeSteps {
+public:
+    void build(float sampleRate) {
+        sampleRate_ = sampleRate;
+        for (std::size_t i = 0; i < attack_.size(); ++i) {
+            attack_[i]  = PatchCurves::envelopeStep(PatchCurves::kAttackSeconds[i], sampleRate);
+            release_[i] = PatchCurves::envelopeStep(PatchCurves::kReleaseSeconds[i], sampleRate);
+        }
+    }
+
+    float step(float seconds) const {
+        int i = Juno106::curveIndexOf(PatchCurves::kAttackSeconds, seconds);
+        if (i >= 0) return attack_[static_cast<std::size_t>(i)];
+        i = Juno106::curveIndexOf(PatchCurves::kReleaseSeconds, seconds);
+        if (i >= 0) return release_[static_cast<std::size_t>(i)];
+        return PatchCurves::envelopeStep(seconds, sampleRate_);
+    }
+
+private:
+    float sampleRate_ = 44100.0f;
+    Juno106::CurveTable attack_{};
+    Juno106::CurveTable release_{};
+};
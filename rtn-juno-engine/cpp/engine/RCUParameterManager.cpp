@@ -1,51 +1,158 @@
 #include "RCUParameterManager.hpp"
+#include <algorithm>
 
-void RCUParameterManager::set(const std::string &id, float value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    params_[id] = value;
-    push({id, value});
-}
+namespace {
 
-float RCUParameterManager::get(const std::string &id, float def) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = params_.find(id);
-    return (it != params_.end())
-           ? it->second
-           : def;
+// Reader registry shared by every store. A reader announces the global epoch
+// it started in; a block retired in epoch E can be freed once every active
+// reader has announced an epoch >= E. Slots are claimed once per thread and
+// never released, so claiming never allocates; threads beyond kMaxReaders
+// fall back to a shared counter that holds off reclamation while non-zero.
+constexpr int kMaxReaders = 64;
+
+struct alignas(64) ReaderSlot {
+    std::atomic<std::uint64_t> epoch{0};   // 0 = not reading
+    std::atomic<bool>          claimed{false};
+};
+
+ReaderSlot                 g_readers[kMaxReaders];
+std::atomic<std::uint64_t> g_epoch{1};
+std::atomic<int>           g_overflowReaders{0};
+
+constexpr int kSlotUnclaimed = -1;
+constexpr int kSlotOverflow  = -2;
+thread_local int t_readerSlot = kSlotUnclaimed;
+
+int readerSlot() {
+    if (t_readerSlot == kSlotUnclaimed) {
+        t_readerSlot = kSlotOverflow;
+        for (int i = 0; i < kMaxReaders; ++i) {
+            bool expected = false;
+            if (g_readers[i].claimed.compare_exchange_strong(expected, true)) {
+                t_readerSlot = i;
+                break;
+            }
+        }
+    }
+    return t_readerSlot;
 }
 
-bool RCUParameterManager::push(const ParamChange &change) {
-    const std::size_t currentHead = head_.load(std::memory_order_relaxed);
-    const std::size_t nextHead = (currentHead + 1) % kQueueCapacity;
-    const std::size_t tailSnapshot = tail_.load(std::memory_order_acquire);
+// Marks the calling thread as reading for its lifetime. Not reentrant.
+class ReadSection {
+public:
+    ReadSection() : slot_(readerSlot()) {
+        if (slot_ >= 0) {
+            g_readers[slot_].epoch.store(g_epoch.load());
+        } else {
+            g_overflowReaders.fetch_add(1);
+        }
+    }
 
-    if (nextHead == tailSnapshot) {
-        // Overwrite the oldest entry to remain lock-free and avoid blocking.
-        tail_.store((tailSnapshot + 1) % kQueueCapacity, std::memory_order_release);
+    ~ReadSection() {
+        if (slot_ >= 0) {
+            g_readers[slot_].epoch.store(0, std::memory_order_release);
+        } else {
+            g_overflowReaders.fetch_sub(1, std::memory_order_release);
+        }
     }
 
-    queue_[currentHead] = change;
-    head_.store(nextHead, std::memory_order_release);
-    return true;
+private:
+    int slot_;
+};
+
+} // namespace
+
+RCUParameterManager::RCUParameterManager()
+    : current_(new Block) {
 }
 
-bool RCUParameterManager::tryPop(ParamChange &change) {
-    const std::size_t currentTail = tail_.load(std::memory_order_relaxed);
-    const std::size_t headSnapshot = head_.load(std::memory_order_acquire);
+RCUParameterManager::~RCUParameterManager() {
+    delete current_.load();
+    for (const auto &r : retired_) {
+        delete r.block;
+    }
+}
 
-    if (currentTail == headSnapshot) {
-        return false;
+void RCUParameterManager::set(const std::string &id, float value) {
+    ParamId param;
+    if (paramIdFromString(id, param)) {
+        set(param, value);
+        return;
     }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto *next = new Block(*current_.load());
+    next->values[id] = value;
+    publish(next);
+}
 
-    change = queue_[currentTail];
-    const std::size_t nextTail = (currentTail + 1) % kQueueCapacity;
-    tail_.store(nextTail, std::memory_order_release);
-    return true;
+void RCUParameterManager::set(ParamId id, float value) {
+    const auto i = static_cast<std::size_t>(id);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto *next = new Block(*current_.load());
+    next->values[paramName(id)] = value;
+    next->byId[i] = value;
+    next->byIdSet |= 1u << i;
+    publish(next);
 }
 
 void RCUParameterManager::clear() {
-    head_.store(0, std::memory_order_release);
-    tail_.store(0, std::memory_order_release);
-    std::lock_guard<std::mutex> lock(mutex_);
-    params_.clear();
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto *next = new Block;
+    next->version = current_.load()->version;
+    publish(next);
+}
+
+float RCUParameterManager::get(const std::string &id, float def) const {
+    ReadSection section;
+    const Block *block = current_.load();
+    auto it = block->values.find(id);
+    return (it != block->values.end())
+           ? it->second
+           : def;
+}
+
+float RCUParameterManager::get(ParamId id, float def) const {
+    const auto i = static_cast<std::size_t>(id);
+    ReadSection section;
+    const Block *block = current_.load();
+    return (block->byIdSet & (1u << i)) ? block->byId[i] : def;
+}
+
+std::uint64_t RCUParameterManager::version() const {
+    ReadSection section;
+    return current_.load()->version;
+}
+
+std::unordered_map<std::string, float> RCUParameterManager::snapshot() const {
+    ReadSection section;
+    return current_.load()->values;
+}
+
+void RCUParameterManager::publish(Block *next) {
+    ++next->version;
+    const Block *old = current_.exchange(next);
+    // Readers that announce the new epoch started after the swap and cannot
+    // see `old`.
+    const std::uint64_t epoch = g_epoch.fetch_add(1) + 1;
+    retired_.push_back({old, epoch});
+    reclaim();
+}
+
+void RCUParameterManager::reclaim() {
+    if (g_overflowReaders.load() != 0) {
+        return;
+    }
+    std::uint64_t oldestReader = UINT64_MAX;
+    for (const auto &reader : g_readers) {
+        const std::uint64_t e = reader.epoch.load();
+        if (e != 0) {
+            oldestReader = std::min(oldestReader, e);
+        }
+    }
+    auto stillVisible = std::partition(retired_.begin(), retired_.end(),
+                                       [&](const Retired &r) { return r.epoch > oldestReader; });
+    for (auto it = stillVisible; it != retired_.end(); ++it) {
+        delete it->block;
+    }
+    retired_.erase(stillVisible, retired_.end());
 }
@@ -1,31 +1,70 @@
 #pragma once
-#include <unordered_map>
-#include <string>
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "EngineEvent.hpp"
+
+// Read-copy-update parameter store.
+//
+// Values live in immutable blocks. set() copies the current block, changes
+// the copy and publishes it with one atomic pointer swap, so readers on any
+// thread (audio, UI, serialisation) never wait and never see a half-applied
+// update, and no update is ever dropped. A replaced block is retired with
+// the epoch it was replaced in and freed by a later writer once no reader can
+// still hold it (epoch-based reclamation). Readers never free or allocate.
+//
+// Engine parameters are also kept in a fixed array indexed by ParamId, so
+// the audio thread reads them with a plain load; names are only hashed on
+// the control side.
 class RCUParameterManager {
 public:
-    struct ParamChange {
-        std::string id;
-        float       value = 0.0f;
-    };
+    RCUParameterManager();
+    ~RCUParameterManager();
+
+    RCUParameterManager(const RCUParameterManager &) = delete;
+    RCUParameterManager &operator=(const RCUParameterManager &) = delete;
 
+    // Writers serialise on a mutex and allocate; keep them off the audio
+    // thread.
     void set(const std::string &id, float value);
-    float get(const std::string &id, float defaultValue = 0.0f) const;
-    bool tryPop(ParamChange &change);
+    void set(ParamId id, float value);
     void clear();
 
+    // Wait-free, from any thread.
+    float get(const std::string &id, float defaultValue = 0.0f) const;
+    // As above, without hashing or building a string; for the audio thread.
+    float get(ParamId id, float defaultValue = 0.0f) const;
+    // Incremented by every set() and clear(), so a reader can skip
+    // re-reading values that have not changed.
+    std::uint64_t version() const;
+
+    // Copy of every value, e.g. for saving a patch. Allocates.
+    std::unordered_map<std::string, float> snapshot() const;
+
 private:
-    static constexpr std::size_t kQueueCapacity = 128;
+    struct Block {
+        std::unordered_map<std::string, float> values;
+        // values[paramName(id)] for every ParamId set; bit id of byIdSet
+        // marks the ones that are.
+        std::array<float, static_cast<std::size_t>(ParamId::Count)> byId{};
+        std::uint32_t byIdSet = 0;
+        std::uint64_t version = 0;
+    };
 
-    std::array<ParamChange, kQueueCapacity> queue_{};
-    std::atomic<std::size_t> head_{0};
-    std::atomic<std::size_t> tail_{0};
+    struct Retired {
+        const Block  *block;
+        std::uint64_t epoch;
+    };
 
-    bool push(const ParamChange &change);
+    void publish(Block *next);   // writeMutex_ held
+    void reclaim();              // writeMutex_ held
 
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, float> params_;
+    std::atomic<const Block *> current_;
+    std::mutex writeMutex_;
+    std::vector<Retired> retired_;
 };
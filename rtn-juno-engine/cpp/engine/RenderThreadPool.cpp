@@ -0,0 +1,149 @@
+#include "RenderThreadPool.hpp"
+
+namespace {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+inline std::uint64_t packRange(int next, int end) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(end)) << 32) |
+           static_cast<std::uint32_t>(next);
+}
+
+} // namespace
+
+RenderThreadPool::~RenderThreadPool() {
+    stop();
+}
+
+bool RenderThreadPool::start(int numWorkers) {
+    stop();
+    if (numWorkers <= 0) {
+        return true;
+    }
+
+    numQueues_ = numWorkers + 1; // slot 0 belongs to the calling thread
+    queues_.reset(new JobQueue[static_cast<std::size_t>(numQueues_)]);
+    quit_.store(false, std::memory_order_release);
+
+    try {
+        workers_.reserve(static_cast<std::size_t>(numWorkers));
+        for (int i = 0; i < numWorkers; ++i) {
+            workers_.emplace_back(&RenderThreadPool::workerLoop, this, i + 1);
+        }
+    } catch (...) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void RenderThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        quit_.store(true, std::memory_order_release);
+    }
+    wake_.notify_all();
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+    queues_.reset();
+    numQueues_ = 0;
+}
+
+void RenderThreadPool::run(JobFn fn, void *context, int numJobs) {
+    if (!fn || numJobs <= 0) return;
+
+    if (workers_.empty()) {
+        for (int j = 0; j < numJobs; ++j) fn(context, j);
+        return;
+    }
+
+    fn_.store(fn, std::memory_order_relaxed);
+    context_.store(context, std::memory_order_relaxed);
+    pending_.store(numJobs, std::memory_order_relaxed);
+
+    // Contiguous slices keep neighbouring voice groups on the same core.
+    for (int q = 0; q < numQueues_; ++q) {
+        const int begin = static_cast<int>(static_cast<long long>(numJobs) * q / numQueues_);
+        const int end   = static_cast<int>(static_cast<long long>(numJobs) * (q + 1) / numQueues_);
+        queues_[q].range.store(packRange(begin, end), std::memory_order_release);
+    }
+
+    // Only a parked worker needs the (syscall) wake-up; spinning ones see
+    // the new generation on their own. seq_cst pairs with the worker's
+    // sleepers_ increment: either it sees this batch before parking or we
+    // see it parked. A wake-up lost in between only costs this batch its
+    // help, since the caller drains every queue itself.
+    generation_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        wake_.notify_all();
+    }
+
+    drain(0);
+
+    // Join: wait for jobs still running on workers.
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        cpuRelax();
+    }
+}
+
+bool RenderThreadPool::takeJob(int slot, int &job) {
+    for (int k = 0; k < numQueues_; ++k) {
+        JobQueue &queue = queues_[(slot + k) % numQueues_];
+        std::uint64_t range = queue.range.load(std::memory_order_acquire);
+        for (;;) {
+            const int next = static_cast<int>(static_cast<std::uint32_t>(range));
+            const int end  = static_cast<int>(static_cast<std::uint32_t>(range >> 32));
+            if (next >= end) break;
+            if (queue.range.compare_exchange_weak(range, packRange(next + 1, end),
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+                job = next;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void RenderThreadPool::drain(int slot) {
+    int job = 0;
+    while (takeJob(slot, job)) {
+        const JobFn fn = fn_.load(std::memory_order_relaxed);
+        fn(context_.load(std::memory_order_relaxed), job);
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void RenderThreadPool::workerLoop(int slot) {
+    std::uint64_t seen = generation_.load(std::memory_order_acquire);
+    auto idle = [&] {
+        return generation_.load(std::memory_order_seq_cst) == seen &&
+               !quit_.load(std::memory_order_acquire);
+    };
+    for (;;) {
+        // Spin briefly: callbacks usually arrive back to back.
+        for (int spins = 0; spins < kSpinIterations && idle(); ++spins) {
+            cpuRelax();
+        }
+        // Then park until there is work, so an idle or silent engine leaves
+        // its workers asleep.
+        if (idle()) {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            wake_.wait(lock, [&] { return !idle(); });
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (quit_.load(std::memory_order_acquire)) return;
+
+        seen = generation_.load(std::memory_order_acquire);
+        drain(slot);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of pre-spawned worker threads for splitting one audio callback
+// across cores.
+//
+// run() hands out a batch of jobs and returns only once every job has
+// finished, so the callback thread joins its workers within the same
+// callback. Each participant (the caller plus every worker) owns a queue
+// holding a contiguous slice of the batch; when its own queue runs dry it
+// steals from the others. Each queue is one atomic word, so taking or
+// stealing a job never locks or allocates. The calling thread also works
+// through the queues, so a batch completes even if no worker wakes up.
+class RenderThreadPool {
+public:
+    using JobFn = void (*)(void *context, int job);
+
+    RenderThreadPool() = default;
+    ~RenderThreadPool();
+
+    RenderThreadPool(const RenderThreadPool &) = delete;
+    RenderThreadPool &operator=(const RenderThreadPool &) = delete;
+
+    // Spawns `numWorkers` threads. Not real-time safe; call from setup code.
+    bool start(int numWorkers);
+    void stop();
+
+    int workerCount() const { return static_cast<int>(workers_.size()); }
+
+    // Runs fn(context, job) for every job in [0, numJobs) and waits for all
+    // of them. Must only be called from one thread at a time.
+    void run(JobFn fn, void *context, int numJobs);
+
+private:
+    // next (low 32 bits) and end (high 32 bits) of a queue's slice, packed
+    // so that taking a job and resetting the queue are single atomic ops.
+    struct alignas(64) JobQueue {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    // Spin iterations before an idle worker goes to sleep.
+    static constexpr int kSpinIterations = 20000;
+
+    void workerLoop(int slot);
+    void drain(int slot);
+    bool takeJob(int slot, int &job);
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<JobQueue[]> queues_;
+    int numQueues_ = 0;
+
+    std::atomic<JobFn> fn_{nullptr};
+    std::atomic<void *> context_{nullptr};
+
+    alignas(64) std::atomic<std::uint64_t> generation_{0};
+    alignas(64) std::atomic<int> pending_{0};
+    std::atomic<int> sleepers_{0};
+    std::atomic<bool> quit_{false};
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+};
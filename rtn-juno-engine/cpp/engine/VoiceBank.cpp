@@ -0,0 +1,535 @@
+#include "VoiceBank.hpp"
+#include <algorithm>
+#include <cmath>
+
+void VoiceBank::initialize(float sr, int numVoices, int maxFrames,
+                           bool perVoiceChorus) {
+    sampleRate_ = sr;
+    filterRate_ = sr * static_cast<float>(oversampling_);
+    numVoices_  = std::max(numVoices, 0);
+    maxFrames_  = std::max(maxFrames, 1);
+
+    smoothing_.configure(sr);
+    envelopeSteps_.build(sr);
+    attackStep_  = envelopeSteps_.step(attack_);
+    decayStep_   = envelopeSteps_.step(decay_);
+    releaseStep_ = envelopeSteps_.step(release_);
+    fadeStep_    = envelopeSteps_.step(kFadeSeconds);
+
+    const int groups = (numVoices_ + kLanes - 1) / kLanes;
+    groups_.assign(static_cast<std::size_t>(groups), LaneGroup{});
+    for (auto &g : groups_) {
+        g.cutoff.fill(1000.0f);
+        g.resonance.fill(0.1f);
+        g.pwmDepth.fill(pwmDepth_);
+        g.subLevel.fill(0.0f);
+        for (int l = 0; l < kLanes; ++l) {
+            updateFilterCoefficients(g, l);
+            landRamps(g, l);
+        }
+        std::fill(std::begin(g.midiNote), std::end(g.midiNote), -1);
+        g.oversampler.setFactor(oversampling_);
+    }
+
+    chorus_.clear();
+    if (perVoiceChorus) {
+        chorus_.assign(static_cast<std::size_t>(numVoices_), BBDChorus{});
+        for (auto &c : chorus_) {
+            c.configure(sr);
+            c.setMode(BBDChorus::Mode::I);
+        }
+    }
+
+    laneScratch_.assign(static_cast<std::size_t>(groups) * 2 * kLanes * maxFrames_, 0.0f);
+}
+
+void VoiceBank::noteOn(int voice, int midiNote, float vel) {
+    if (voice < 0 || voice >= numVoices_) return;
+    LaneGroup &g = groupOf(voice);
+    const int l = voice % kLanes;
+    g.active[l]    = 1.0f;
+    g.velocity[l]  = vel;
+    g.midiNote[l]  = midiNote;
+    g.frequency[l] = Juno106::ParameterScaler::noteToHz(midiNote);
+    g.envLevel[l]  = 0.0f;
+    g.envTarget[l] = 1.0f;
+    g.envStep[l]   = attackStep_;
+    g.envStage[l]  = EnvelopeStage::Attack;
+    g.fading[l]    = 0.0f;
+    g.phase[l]     = 0.0f;
+    g.subPhase[l]  = 0.0f;
+    g.oversampler.resetLane(l);
+
+    // A new note starts on the current settings rather than mid-ramp. Settled
+    // coefficients are already current, so only a cut-short ramp recomputes.
+    const bool cutoffMoved = g.cutoff.snap(l);
+    const bool resonanceMoved = g.resonance.snap(l);
+    g.pwmDepth.snap(l);
+    g.subLevel.snap(l);
+    if (cutoffMoved || resonanceMoved) updateFilterCoefficients(g, l);
+    landRamps(g, l);
+}
+
+void VoiceBank::noteOff(int voice, int midiNote) {
+    if (voice < 0 || voice >= numVoices_) return;
+    LaneGroup &g = groupOf(voice);
+    const int l = voice % kLanes;
+    if (g.active[l] == 0.0f || g.midiNote[l] != midiNote) {
+        return;
+    }
+    g.envTarget[l] = 0.0f;
+    g.envStep[l]   = (g.fading[l] != 0.0f) ? fadeStep_ : releaseStep_;
+    g.envStage[l]  = EnvelopeStage::Release;
+}
+
+void VoiceBank::fadeOut(int voice) {
+    if (voice < 0 || voice >= numVoices_) return;
+    LaneGroup &g = groupOf(voice);
+    const int l = voice % kLanes;
+    if (g.active[l] == 0.0f) return;
+    g.envTarget[l] = 0.0f;
+    g.envStep[l]   = fadeStep_;
+    g.envStage[l]  = EnvelopeStage::Release;
+    g.fading[l]    = 1.0f;
+}
+
+void VoiceBank::setOversampling(int factor) {
+    oversampling_ = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+    filterRate_ = sampleRate_ * static_cast<float>(oversampling_);
+    for (auto &g : groups_) {
+        g.oversampler.setFactor(oversampling_);
+        for (int l = 0; l < kLanes; ++l) {
+            updateFilterCoefficients(g, l);
+            landRamps(g, l);
+        }
+    }
+}
+
+float VoiceBank::latencyFrames() const {
+    return Oversampler<kLanes>::latencyFor(oversampling_);
+}
+
+void VoiceBank::setParam(ParamId id, float v) {
+    switch (id) {
+        case ParamId::Cutoff:
+            for (auto &g : groups_) g.cutoff.setTargetAll(v, smoothing_.cutoff);
+            break;
+        case ParamId::Resonance:
+            for (auto &g : groups_) g.resonance.setTargetAll(v, smoothing_.resonance);
+            break;
+        case ParamId::Attack:
+            attack_     = std::max(0.0005f, v);
+            attackStep_ = envelopeSteps_.step(attack_);
+            refreshEnvelopeSegments();
+            break;
+        case ParamId::Decay:
+            decay_     = std::max(0.0005f, v);
+            decayStep_ = envelopeSteps_.step(decay_);
+            refreshEnvelopeSegments();
+            break;
+        case ParamId::Sustain:
+            sustain_ = std::clamp(v, 0.0f, 1.0f);
+            refreshEnvelopeSegments();
+            break;
+        case ParamId::Release:
+            release_     = std::max(0.0005f, v);
+            releaseStep_ = envelopeSteps_.step(release_);
+            refreshEnvelopeSegments();
+            break;
+        case ParamId::PwmDepth:
+            pwmDepth_ = v;
+            for (auto &g : groups_) g.pwmDepth.setTargetAll(v, smoothing_.pwmDepth);
+            break;
+        case ParamId::SubLevel:
+            for (auto &g : groups_) g.subLevel.setTargetAll(v, smoothing_.subLevel);
+            break;
+        case ParamId::ChorusMode: {
+            const auto mode = BBDChorus::modeFromIndex(static_cast<int>(v));
+            for (auto &c : chorus_) c.setMode(mode);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool VoiceBank::anyActive() const {
+    for (const auto &g : groups_) {
+        for (int l = 0; l < kLanes; ++l) {
+            if (g.active[l] != 0.0f) return true;
+        }
+    }
+    return false;
+}
+
+bool VoiceBank::isActive(int voice) const {
+    return groupOf(voice).active[voice % kLanes] != 0.0f;
+}
+
+int VoiceBank::midiNote(int voice) const {
+    return groupOf(voice).midiNote[voice % kLanes];
+}
+
+float VoiceBank::frequency(int voice) const {
+    return groupOf(voice).frequency[voice % kLanes];
+}
+
+float VoiceBank::velocity(int voice) const {
+    return groupOf(voice).velocity[voice % kLanes];
+}
+
+float VoiceBank::envelopeLevel(int voice) const {
+    return groupOf(voice).envLevel[voice % kLanes];
+}
+
+float VoiceBank::phase(int voice) const {
+    return groupOf(voice).phase[voice % kLanes];
+}
+
+void VoiceBank::refreshEnvelopeSegments() {
+    for (auto &g : groups_) {
+        for (int l = 0; l < kLanes; ++l) {
+            const float stage = g.envStage[l];
+            if (stage == EnvelopeStage::Attack) {
+                g.envStep[l] = attackStep_;
+            } else if (stage == EnvelopeStage::Decay) {
+                g.envTarget[l] = sustain_;
+                g.envStep[l]   = decayStep_;
+            } else if (stage == EnvelopeStage::Release && g.fading[l] == 0.0f) {
+                g.envStep[l] = releaseStep_;
+            }
+        }
+    }
+}
+
+void VoiceBank::updateFilterCoefficients(LaneGroup &g, int l) const {
+    g.vcfGain[l]     = NonlinearVCF::stageGain(g.cutoff.value[l], filterRate_);
+    g.vcfFeedback[l] = NonlinearVCF::feedbackGain(g.resonance.value[l]);
+}
+
+void VoiceBank::landRamps(LaneGroup &g, int l) const {
+    g.gainNow[l] = g.vcfGain[l];
+    g.fbNow[l]   = g.vcfFeedback[l];
+    g.pwmNow[l]  = VoiceSmoothing::clampPulseWidth(g.pwmDepth.value[l]);
+    g.subNow[l]  = g.subLevel.value[l];
+    g.dGain[l] = g.dFb[l] = g.dPwm[l] = g.dSub[l] = 0.0f;
+}
+
+unsigned VoiceBank::renderGroup(int group, float *left, float *right,
+                                std::size_t stride, int n) {
+    LaneGroup &g = groups_[static_cast<std::size_t>(group)];
+    const int firstVoice = group * kLanes;
+    const int lanes = std::min(kLanes, numVoices_ - firstVoice);
+    n = std::min(n, maxFrames_);
+
+    unsigned startMask = 0;
+    for (int l = 0; l < lanes; ++l) {
+        if (g.active[l] != 0.0f) startMask |= 1u << l;
+    }
+    if (startMask == 0 || n <= 0) {
+        // Idle lanes do not ramp, but the sub-block clock keeps time.
+        g.smoothingFrame = (g.smoothingFrame + std::max(n, 0)) % kSmoothingFrames;
+        for (int l = 0; l < lanes; ++l) {
+            std::fill(left + l * stride, left + l * stride + n, 0.0f);
+            if (!chorus_.empty()) {
+                std::fill(right + l * stride, right + l * stride + n, 0.0f);
+            }
+        }
+        return 0;
+    }
+
+    // Block constants, per lane where the parameter is per voice.
+    const float invSr       = 1.0f / std::max(sampleRate_, 1.0f);
+    const float sustain     = sustain_;
+    const float decayStep   = decayStep_;
+    const bool  eco         = quality_ == Quality::Eco;
+
+    alignas(32) float phaseInc[kLanes];
+    alignas(32) float subInc[kLanes];
+    alignas(32) float invInc[kLanes], invSubInc[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        phaseInc[l]  = g.frequency[l] * invSr;
+        subInc[l]    = (g.frequency[l] * 0.5f) * invSr;
+        invInc[l]    = polyblep::inverseIncrement(phaseInc[l]);
+        invSubInc[l] = polyblep::inverseIncrement(subInc[l]);
+    }
+
+    // Smoothed per-lane coefficients, stepped by d* once per sample and
+    // reloaded at every sub-block boundary; carried over from the last call.
+    alignas(32) float gain[kLanes], fb[kLanes], pwm[kLanes], subLevel[kLanes];
+    alignas(32) float dGain[kLanes], dFb[kLanes], dPwm[kLanes], dSub[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        gain[l] = g.gainNow[l];
+        fb[l] = g.fbNow[l];
+        pwm[l] = g.pwmNow[l];
+        subLevel[l] = g.subNow[l];
+        dGain[l] = g.dGain[l];
+        dFb[l] = g.dFb[l];
+        dPwm[l] = g.dPwm[l];
+        dSub[l] = g.dSub[l];
+    }
+    int smoothingFrame = g.smoothingFrame;
+
+    // Lane state lives in locals for the whole block.
+    alignas(32) float env[kLanes];
+    alignas(32) float target[kLanes];
+    alignas(32) float envStep[kLanes];
+    alignas(32) float envStage[kLanes];
+    alignas(32) float phase[kLanes];
+    alignas(32) float subPhase[kLanes];
+    alignas(32) float alive[kLanes];
+    alignas(32) float s0[kLanes], s1[kLanes], s2[kLanes], s3[kLanes];
+    alignas(32) float x[kLanes];
+    int rendered[kLanes] = {};
+    for (int l = 0; l < kLanes; ++l) {
+        env[l]      = g.envLevel[l];
+        target[l]   = g.envTarget[l];
+        envStep[l]  = g.envStep[l];
+        envStage[l] = g.envStage[l];
+        phase[l]    = g.phase[l];
+        subPhase[l] = g.subPhase[l];
+        alive[l]    = g.active[l];
+        s0[l] = g.stage[0][l];
+        s1[l] = g.stage[1][l];
+        s2[l] = g.stage[2][l];
+        s3[l] = g.stage[3][l];
+    }
+
+    // One filter step for every lane at the filter rate: feedback, input
+    // saturation, four one-pole stages (frozen on idle lanes) and output
+    // saturation. `in` and `out` may alias.
+    alignas(32) float drive[kLanes];
+    alignas(32) float upsampled[Oversampler<kLanes>::kMaxFactor * kLanes];
+    const int oversampling = oversampling_;
+    auto filterFrame = [&](const float *in, float *out) {
+        for (int l = 0; l < kLanes; ++l) {
+            x[l] = in[l] - fb[l] * s3[l];
+        }
+
+        if (eco) {
+            for (int l = 0; l < kLanes; ++l) {
+                x[l] = NonlinearVCF::fastSoftClip(x[l]);
+            }
+        } else {
+            for (int l = 0; l < kLanes; ++l) {
+                x[l] = NonlinearVCF::softClip(x[l]);
+            }
+        }
+
+        for (int l = 0; l < kLanes; ++l) {
+            const bool on = alive[l] != 0.0f;
+            const float n0 = s0[l] + gain[l] * (x[l] - s0[l]);
+            const float n1 = s1[l] + gain[l] * (n0 - s1[l]);
+            const float n2 = s2[l] + gain[l] * (n1 - s2[l]);
+            const float n3 = s3[l] + gain[l] * (n2 - s3[l]);
+            s0[l] = on ? n0 : s0[l];
+            s1[l] = on ? n1 : s1[l];
+            s2[l] = on ? n2 : s2[l];
+            s3[l] = on ? n3 : s3[l];
+        }
+
+        if (eco) {
+            for (int l = 0; l < kLanes; ++l) {
+                out[l] = NonlinearVCF::fastSoftClip(s3[l]);
+            }
+        } else {
+            for (int l = 0; l < kLanes; ++l) {
+                out[l] = NonlinearVCF::softClip(s3[l]);
+            }
+        }
+    };
+
+    float *filtered = laneScratch_.data() +
+                      static_cast<std::size_t>(group) * 2 * kLanes * maxFrames_;
+    float *envOut   = filtered + static_cast<std::size_t>(kLanes) * maxFrames_;
+
+    for (int i = 0; i < n; ++i) {
+        // Sub-block boundary: advance the ramps and spread the change in the
+        // stage-ready coefficients over the next kSmoothingFrames samples.
+        if (smoothingFrame == 0) {
+            constexpr float invLen = 1.0f / static_cast<float>(kSmoothingFrames);
+            for (int l = 0; l < kLanes; ++l) {
+                gain[l]     = g.vcfGain[l];
+                fb[l]       = g.vcfFeedback[l];
+                pwm[l]      = VoiceSmoothing::clampPulseWidth(g.pwmDepth.value[l]);
+                subLevel[l] = g.subLevel.value[l];
+            }
+            const bool cutoffMoved = g.cutoff.advance(smoothing_.cutoff);
+            const bool resonanceMoved = g.resonance.advance(smoothing_.resonance);
+            g.pwmDepth.advance(smoothing_.pwmDepth);
+            g.subLevel.advance(smoothing_.subLevel);
+            for (int l = 0; l < kLanes; ++l) {
+                if (cutoffMoved) {
+                    g.vcfGain[l] = NonlinearVCF::stageGain(g.cutoff.value[l], filterRate_);
+                }
+                if (resonanceMoved) {
+                    g.vcfFeedback[l] = NonlinearVCF::feedbackGain(g.resonance.value[l]);
+                }
+                dGain[l] = (g.vcfGain[l] - gain[l]) * invLen;
+                dFb[l]   = (g.vcfFeedback[l] - fb[l]) * invLen;
+                dPwm[l]  = (VoiceSmoothing::clampPulseWidth(g.pwmDepth.value[l]) - pwm[l]) * invLen;
+                dSub[l]  = (g.subLevel.value[l] - subLevel[l]) * invLen;
+            }
+        }
+        for (int l = 0; l < kLanes; ++l) {
+            gain[l]     += dGain[l];
+            fb[l]       += dFb[l];
+            pwm[l]      += dPwm[l];
+            subLevel[l] += dSub[l];
+        }
+        smoothingFrame = smoothingFrame + 1 == kSmoothingFrames ? 0 : smoothingFrame + 1;
+
+        // Envelope and voice retirement.
+        for (int l = 0; l < kLanes; ++l) {
+            const float e = stepEnvelope(env[l], target[l], envStep[l], envStage[l],
+                                         sustain, decayStep);
+            const bool wasAlive = alive[l] != 0.0f;
+            const bool dies = e * g.velocity[l] < kRetireLevel && target[l] == 0.0f;
+            env[l]   = wasAlive ? e : env[l];
+            alive[l] = (wasAlive && !dies) ? 1.0f : 0.0f;
+        }
+
+        // Band-limited oscillators, frozen on idle lanes.
+        for (int l = 0; l < kLanes; ++l) {
+            const bool on = alive[l] != 0.0f;
+            float p = phase[l] + phaseInc[l];
+            p = (p >= 1.0f) ? p - 1.0f : p;
+            float sp = subPhase[l] + subInc[l];
+            sp = (sp >= 1.0f) ? sp - 1.0f : sp;
+            phase[l]    = on ? p : phase[l];
+            subPhase[l] = on ? sp : subPhase[l];
+
+            const float osc = polyblep::sawPulse(p, pwm[l], phaseInc[l], invInc[l]);
+            const float sub = polyblep::sub(sp, subInc[l], invSubInc[l]) * subLevel[l];
+            drive[l] = osc + sub;
+        }
+
+        float *fOut = filtered + static_cast<std::size_t>(i) * kLanes;
+        float *eOut = envOut + static_cast<std::size_t>(i) * kLanes;
+        if (oversampling == 1) {
+            filterFrame(drive, fOut);
+        } else {
+            g.oversampler.upsample(drive, upsampled);
+            for (int f = 0; f < oversampling; ++f) {
+                float *frame = upsampled + f * kLanes;
+                filterFrame(frame, frame);
+            }
+            g.oversampler.downsample(upsampled, fOut);
+        }
+        for (int l = 0; l < kLanes; ++l) {
+            rendered[l] = (alive[l] != 0.0f) ? i + 1 : rendered[l];
+        }
+        for (int l = 0; l < kLanes; ++l) {
+            eOut[l] = env[l];
+        }
+    }
+
+    g.smoothingFrame = smoothingFrame;
+    for (int l = 0; l < kLanes; ++l) {
+        g.gainNow[l] = gain[l];
+        g.fbNow[l]   = fb[l];
+        g.pwmNow[l]  = pwm[l];
+        g.subNow[l]  = subLevel[l];
+        g.dGain[l]   = dGain[l];
+        g.dFb[l]     = dFb[l];
+        g.dPwm[l]    = dPwm[l];
+        g.dSub[l]    = dSub[l];
+        g.envLevel[l]  = env[l];
+        g.envTarget[l] = target[l];
+        g.envStep[l]   = envStep[l];
+        g.envStage[l]  = envStage[l];
+        g.phase[l]     = phase[l];
+        g.subPhase[l]  = subPhase[l];
+        g.stage[0][l]  = s0[l];
+        g.stage[1][l]  = s1[l];
+        g.stage[2][l]  = s2[l];
+        g.stage[3][l]  = s3[l];
+        if (g.active[l] != 0.0f && alive[l] == 0.0f) {
+            g.midiNote[l] = -1;
+        }
+        g.active[l] = alive[l];
+    }
+
+    // Without per-voice chorus only the enveloped mono signal is needed.
+    if (chorus_.empty()) {
+        for (int l = 0; l < lanes; ++l) {
+            float *out = left + l * stride;
+            if (!(startMask & (1u << l))) {
+                std::fill(out, out + n, 0.0f);
+                continue;
+            }
+            const float vel = g.velocity[l];
+            const int count = rendered[l];
+            for (int i = 0; i < count; ++i) {
+                const std::size_t idx = static_cast<std::size_t>(i) * kLanes + l;
+                out[i] = filtered[idx] * envOut[idx] * vel;
+            }
+            std::fill(out + count, out + n, 0.0f);
+        }
+        return startMask;
+    }
+
+    // Per-voice chorus and amplitude, de-interleaving into the voice outputs.
+    for (int l = 0; l < lanes; ++l) {
+        float *outL = left + l * stride;
+        float *outR = right + l * stride;
+        if (!(startMask & (1u << l))) {
+            std::fill(outL, outL + n, 0.0f);
+            std::fill(outR, outR + n, 0.0f);
+            continue;
+        }
+
+        BBDChorus &chorus = chorus_[static_cast<std::size_t>(firstVoice + l)];
+        const float vel = g.velocity[l];
+        const int count = rendered[l];
+        for (int i = 0; i < count; ++i) {
+            const std::size_t idx = static_cast<std::size_t>(i) * kLanes + l;
+            const float envAtSample = envOut[idx];
+            float wetL = 0.0f;
+            float wetR = 0.0f;
+            chorus.process(filtered[idx], wetL, wetR);
+            outL[i] = wetL * envAtSample * vel;
+            outR[i] = wetR * envAtSample * vel;
+        }
+        std::fill(outL + count, outL + n, 0.0f);
+        std::fill(outR + count, outR + n, 0.0f);
+    }
+
+    return startMask;
+}
+
+void VoiceBank::advanceState(int numFrames) {
+    const float invSr = 1.0f / std::max(sampleRate_, 1.0f);
+
+    for (auto &g : groups_) {
+        // The GPU path renders whole blocks at fixed settings; land the
+        // ramps so the CPU state follows what it heard.
+        for (int l = 0; l < kLanes; ++l) {
+            g.cutoff.snap(l);
+            g.resonance.snap(l);
+            g.pwmDepth.snap(l);
+            g.subLevel.snap(l);
+            updateFilterCoefficients(g, l);
+            landRamps(g, l);
+        }
+        g.smoothingFrame = (g.smoothingFrame + numFrames) % kSmoothingFrames;
+        for (int l = 0; l < kLanes; ++l) {
+            if (g.active[l] == 0.0f) continue;
+            const float phaseInc = g.frequency[l] * invSr;
+            const float subInc   = (g.frequency[l] * 0.5f) * invSr;
+            for (int i = 0; i < numFrames; ++i) {
+                g.envLevel[l] = stepEnvelope(g.envLevel[l], g.envTarget[l], g.envStep[l],
+                                             g.envStage[l], sustain_, decayStep_);
+                if (g.envLevel[l] * g.velocity[l] < kRetireLevel && g.envTarget[l] == 0.0f) {
+                    g.active[l]   = 0.0f;
+                    g.midiNote[l] = -1;
+                    break;
+                }
+                g.phase[l] += phaseInc;
+                if (g.phase[l] >= 1.0f) g.phase[l] -= 1.0f;
+                g.subPhase[l] += subInc;
+                if (g.subPhase[l] >= 1.0f) g.subPhase[l] -= 1.0f;
+            }
+        }
+    }
+}
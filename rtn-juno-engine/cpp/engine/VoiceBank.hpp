@@ -0,0 +1,155 @@
+#pragma once
+#include "../dsp/NonlinearVCF.hpp"
+#include "../dsp/BBDChorus.hpp"
+#include "Oversampler.hpp"
+#include "PolyBLEP.hpp"
+#include "EngineEvent.hpp"
+#include "EnvelopeSegments.hpp"
+#include "ParameterSmoother.hpp"
+#include "PatchCurves.hpp"
+#include <cstddef>
+#include <vector>
+
+// Structure-of-arrays voice storage for the CPU path.
+//
+// Voices are packed into groups of kLanes. All voices of a group advance in
+// lockstep, one lane each, so the per-sample envelope, oscillator and
+// NonlinearVCF stage math is written as fixed-width lane loops that the
+// compiler maps onto SSE/NEON (4 lanes) or AVX2 (8 lanes) registers.
+// The per-sample behaviour matches JunoVoice, which stays as the scalar
+// reference implementation.
+//
+// Cutoff, resonance, pulse width and sub level are smoothed per lane (see
+// ParameterSmoother): each kSmoothingFrames sub-block the ramps advance once
+// and the stage-ready filter gain/feedback are interpolated across it.
+//
+// With oversampling the saturating filter runs at 2x or 4x the sample rate
+// behind a lane-wide Oversampler; the oscillators and envelopes stay at the
+// base rate.
+class VoiceBank {
+public:
+#if defined(__AVX2__)
+    static constexpr int kLanes = 8;
+#else
+    static constexpr int kLanes = 4;
+#endif
+
+    // Eco swaps the filter's tanh saturation for NonlinearVCF::fastSoftClip.
+    enum class Quality {
+        Full,
+        Eco
+    };
+
+    // With perVoiceChorus every voice owns a BBDChorus and renders stereo.
+    // Otherwise voices render the mono, enveloped signal into `left` only
+    // and the caller runs a shared chorus on the voice sum.
+    void initialize(float sampleRate, int numVoices, int maxFrames,
+                    bool perVoiceChorus = false);
+
+    int size() const { return numVoices_; }
+    int groupCount() const { return static_cast<int>(groups_.size()); }
+    bool perVoiceChorus() const { return !chorus_.empty(); }
+
+    void noteOn(int voice, int midiNote, float velocity);
+    void noteOff(int voice, int midiNote);
+    // Releases `voice` over kFadeSeconds whatever the patch release is, e.g.
+    // when the voice limit drops.
+    void fadeOut(int voice);
+    void setQuality(Quality quality) { quality_ = quality; }
+    Quality quality() const { return quality_; }
+    // Runs the filter at 1, 2 or 4 times the sample rate. Clears the
+    // oversampler history, so call it between notes or at setup.
+    void setOversampling(int factor);
+    int oversampling() const { return oversampling_; }
+    // Delay the oversampler adds to the voice output, in base-rate frames.
+    float latencyFrames() const;
+    void setParam(ParamId id, float value);
+    void advanceState(int numFrames);
+
+    // Render `numFrames` (<= maxFrames) of every voice in `group`. Voice
+    // (group * kLanes + lane) writes to left/right + lane * stride, replacing
+    // the previous contents; `right` is left untouched unless the bank uses
+    // per-voice chorus. Returns a bit mask of the lanes that produced audio;
+    // inactive lanes are filled with silence.
+    unsigned renderGroup(int group, float *left, float *right,
+                         std::size_t stride, int numFrames);
+
+    // A voice is retired once envelope * velocity falls below this (-80 dB).
+    static constexpr float kRetireLevel = 1e-4f;
+    static constexpr float kFadeSeconds = 0.005f;
+
+    bool  anyActive() const;
+    bool  isActive(int voice) const;
+    int   midiNote(int voice) const;
+    float frequency(int voice) const;
+    float velocity(int voice) const;
+    float envelopeLevel(int voice) const;
+    float phase(int voice) const;
+    float pulseWidth() const { return pwmDepth_; }
+
+private:
+    struct alignas(32) LaneGroup {
+        float phase[kLanes]     = {};
+        float subPhase[kLanes]  = {};
+        float frequency[kLanes] = {};
+        float velocity[kLanes]  = {};
+        float envLevel[kLanes]  = {};
+        float envTarget[kLanes] = {};   // current segment (EnvelopeSegments.hpp)
+        float envStep[kLanes]   = {};
+        float envStage[kLanes]  = {};
+        SmoothedLanes<kLanes> cutoff;
+        SmoothedLanes<kLanes> resonance;
+        SmoothedLanes<kLanes> pwmDepth;
+        SmoothedLanes<kLanes> subLevel;
+        float vcfGain[kLanes]     = {};   // stageGain() of cutoff.value
+        float vcfFeedback[kLanes] = {};   // feedbackGain() of resonance.value
+        // Coefficients interpolated across the current sub-block and their
+        // per-sample steps. Kept across renderGroup() calls, with the
+        // position in the sub-block, so ramps advance every kSmoothingFrames
+        // samples however the engine splits its blocks.
+        float gainNow[kLanes] = {}, fbNow[kLanes] = {}, pwmNow[kLanes] = {}, subNow[kLanes] = {};
+        float dGain[kLanes] = {}, dFb[kLanes] = {}, dPwm[kLanes] = {}, dSub[kLanes] = {};
+        int   smoothingFrame = 0;
+        float stage[4][kLanes]  = {};
+        float active[kLanes]    = {};   // 1.0f = sounding, 0.0f = idle
+        float fading[kLanes]    = {};   // 1.0f = releasing at fadeStep_
+        Oversampler<kLanes> oversampler;
+        int   midiNote[kLanes]  = {};
+    };
+
+    float sampleRate_ = 44100.0f;
+    float filterRate_ = 44100.0f;   // sampleRate_ * oversampling_
+    int   oversampling_ = 1;
+    int   numVoices_  = 0;
+    int   maxFrames_  = 0;
+
+    float attack_     = 0.01f;
+    float decay_      = 0.3f;
+    float sustain_    = 1.0f;
+    float release_    = 0.5f;
+    float pwmDepth_   = 0.5f;
+    float attackStep_  = 1.0f;
+    float decayStep_   = 1.0f;
+    float releaseStep_ = 1.0f;
+    float fadeStep_    = 1.0f;
+    Quality quality_   = Quality::Full;
+
+    VoiceSmoothing smoothing_;
+    EnvelopeSteps  envelopeSteps_;
+
+    std::vector<LaneGroup> groups_;
+    std::vector<BBDChorus> chorus_;   // empty unless per-voice chorus is on
+
+    // Per-group lane-interleaved scratch: [group][frame][lane] for the
+    // filtered signal followed by the same layout for the envelope level.
+    std::vector<float> laneScratch_;
+
+    void  updateFilterCoefficients(LaneGroup &g, int lane) const;
+    // Ends the lane's interpolation on its current coefficients.
+    void  landRamps(LaneGroup &g, int lane) const;
+    // Re-reads the ADSR settings into every sounding lane's current segment.
+    void  refreshEnvelopeSegments();
+
+    LaneGroup &groupOf(int voice) { return groups_[static_cast<std::size_t>(voice / kLanes)]; }
+    const LaneGroup &groupOf(int voice) const { return groups_[static_cast<std::size_t>(voice / kLanes)]; }
+};
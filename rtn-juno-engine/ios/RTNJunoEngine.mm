@@ -2,6 +2,7 @@
 #import <AVFoundation/AVFoundation.h>
 #import <React/RCTEventEmitter.h>
 #import <React/RCTBridgeModule.h>
+#import <algorithm>
 #import <cstring>
 #include <exception>
 
@@ -66,6 +67,7 @@ RCT_EXPORT_METHOD(initialize:(NSDictionary *)config)
   }
 
   _dspEngine = std::make_unique<JunoDSPEngine>();
+  _dspEngine->setAdaptiveQuality(true);
   if (!_dspEngine->initialize(sr, bs, 8, gpu)) {
     [self sendEventWithName:EVENT_ERROR
                        body:@{ @"message": @"Failed to initialize DSP engine" }];
@@ -91,29 +93,36 @@ RCT_EXPORT_METHOD(initialize:(NSDictionary *)config)
         for (UInt32 i = 0; i < outputData->mNumberBuffers; ++i) {
           std::memset(outputData->mBuffers[i].mData, 0,
                       outputData->mBuffers[i].mDataByteSize);
-        if (!right) {
-          // mono buffer: render to a temporary stereo buffer and mix down.
-          std::vector<float> tempL(frameCount);
-          std::vector<float> tempR(frameCount);
-          strongSelf->_dspEngine->renderAudio(tempL.data(), tempR.data(), static_cast<int>(frameCount));
-          for (AVAudioFrameCount i = 0; i < frameCount; ++i) {
-              left[i] = (tempL[i] + tempR[i]) * 0.5f;
-          }
-        } else {
+        }
+        return noErr;
+      }
+
+      float *left = (float *)outputData->mBuffers[0].mData;
       float *right = (outputData->mNumberBuffers > 1)
                      ? (float *)outputData->mBuffers[1].mData
                      : nullptr;
 
+      bool silent = true;
       if (!right) {
-        // mono buffer: duplicate
-        strongSelf->_dspEngine->renderAudio(left, left,
-                                            static_cast<int>(frameCount));
+        // mono buffer: render in stack-sized stereo chunks and mix down, so
+        // nothing is allocated on the audio thread.
+        constexpr AVAudioFrameCount kChunk = 256;
+        float tempL[kChunk];
+        float tempR[kChunk];
+        for (AVAudioFrameCount pos = 0; pos < frameCount; pos += kChunk) {
+          const AVAudioFrameCount n = std::min(kChunk, frameCount - pos);
+          silent &= strongSelf->_dspEngine->renderAudio(tempL, tempR, static_cast<int>(n));
+          for (AVAudioFrameCount i = 0; i < n; ++i) {
+            left[pos + i] = (tempL[i] + tempR[i]) * 0.5f;
+          }
+        }
       } else {
-        strongSelf->_dspEngine->renderAudio(left, right,
-                                            static_cast<int>(frameCount));
+        silent = strongSelf->_dspEngine->renderAudio(left, right,
+                                                     static_cast<int>(frameCount));
       }
 
-      *isSilence = NO;
+      // Buffers are zero-filled when silent; downstream nodes can skip them.
+      *isSilence = silent ? YES : NO;
       return noErr;
     }];
 
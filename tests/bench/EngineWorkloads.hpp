@@ -0,0 +1,141 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Juno106PatchParser.hpp"
+#include "JunoDSPEngine.hpp"
+
+// The scripted JunoDSPEngine workloads juno_engine_matrix times and the
+// realtime-safety check (tests/rt) renders under its allocation and lock
+// interposer: sustained chords, a voice-stealing arpeggio, a cutoff sweep,
+// patch changes under held notes and long release tails.
+namespace engine_workloads {
+
+// The engine as a script sees it: event times count from the first timed
+// block, not from the engine's own clock, which the warm-up has advanced.
+struct Timeline {
+    JunoDSPEngine &engine;
+    std::int64_t origin;
+
+    void noteOn(int note, float velocity, std::int64_t t) { engine.noteOnAt(note, velocity, origin + t); }
+    void noteOff(int note, std::int64_t t) { engine.noteOffAt(note, origin + t); }
+    void set(ParamId id, float value, std::int64_t t) { engine.setParameterAt(id, value, origin + t); }
+    void loadPatch(const Juno106::JunoPatch &patch) { engine.loadPatch(patch); }
+};
+
+// Schedules the events of one callback: everything in [start, start + frames).
+using Script = std::function<void(Timeline &, std::int64_t start, int frames)>;
+
+struct Workload {
+    const char *name;
+    // Called once after start(), before the warm-up.
+    std::function<void(JunoDSPEngine &)> setup;
+    Script script;
+};
+
+// Calls fn(time, k) for every time = offset + k * period in [start, end).
+template <typename Fn>
+void forEachTick(std::int64_t start, std::int64_t end, std::int64_t period,
+                 std::int64_t offset, Fn &&fn) {
+    std::int64_t k = start <= offset ? 0 : (start - offset + period - 1) / period;
+    for (std::int64_t t = offset + k * period; t < end; t = offset + (++k) * period) {
+        fn(t, k);
+    }
+}
+
+inline Juno106::JunoPatch makePatch(uint8_t cutoff, uint8_t resonance, uint8_t release, bool chorusII) {
+    Juno106::JunoPatch p;
+    p.vcfCutoff = cutoff;
+    p.vcfResonance = resonance;
+    p.envAttack = 4;
+    p.envDecay = 60;
+    p.envSustain = 90;
+    p.envRelease = release;
+    p.dcoSubLevel = 70;
+    p.switches.chorusOn = true;
+    p.switches.chorusLevelII = chorusII;
+    return p;
+}
+
+inline std::vector<Workload> workloads(int sampleRate, int polyphony) {
+    const std::int64_t sr = sampleRate;
+    const int poly = polyphony;
+    std::vector<Workload> list;
+
+    // Every voice held; the chord moves every two seconds.
+    list.push_back({"sustained_chords", [](JunoDSPEngine &) {},
+        [=](Timeline &e, std::int64_t start, int frames) {
+            forEachTick(start, start + frames, 2 * sr, 0, [&](std::int64_t t, std::int64_t k) {
+                const int base = 36 + static_cast<int>(k % 4) * 5;
+                const int previous = 36 + static_cast<int>((k + 3) % 4) * 5;
+                for (int v = 0; v < poly; ++v) {
+                    if (k > 0) e.noteOff(previous + 3 * v, t);
+                    e.noteOn(base + 3 * v, 0.8f, t);
+                }
+            });
+        }});
+
+    // 16ths at 250 bpm, each held for poly + 2 steps, so every new note
+    // has to steal a voice.
+    list.push_back({"arpeggio_stealing",
+        [](JunoDSPEngine &e) { e.setParameter(ParamId::Release, 0.3f); },
+        [=](Timeline &e, std::int64_t start, int frames) {
+            const std::int64_t step = sr * 60 / 1000;
+            static const int pattern[] = {0, 4, 7, 12, 16, 12, 7, 4};
+            forEachTick(start, start + frames, step, 0, [&](std::int64_t t, std::int64_t k) {
+                const int note = 48 + pattern[k % 8] + 12 * static_cast<int>((k / 8) % 3);
+                e.noteOn(note, 0.7f + 0.05f * static_cast<float>(k % 4), t);
+                e.noteOff(note, t + (poly + 2) * step);
+            });
+        }});
+
+    // Held voices under a continuous cutoff and resonance sweep, updated
+    // every 64 samples.
+    list.push_back({"cutoff_sweep", [](JunoDSPEngine &) {},
+        [=](Timeline &e, std::int64_t start, int frames) {
+            if (start == 0) {
+                for (int v = 0; v < poly; ++v) e.noteOn(40 + 4 * v, 0.8f, 0);
+            }
+            forEachTick(start, start + frames, 64, 0, [&](std::int64_t t, std::int64_t) {
+                const double s = static_cast<double>(t) / static_cast<double>(sr);
+                const double sweep = 0.5 + 0.5 * std::sin(2.0 * 3.14159265358979 * s / 1.5);
+                e.set(ParamId::Cutoff, static_cast<float>(100.0 * std::pow(120.0, sweep)), t);
+                e.set(ParamId::Resonance, static_cast<float>(0.2 + 0.6 * (1.0 - sweep)), t);
+            });
+        }});
+
+    // Held voices while the patch changes every 250 ms.
+    list.push_back({"patch_changes", [](JunoDSPEngine &) {},
+        [=](Timeline &e, std::int64_t start, int frames) {
+            if (start == 0) {
+                for (int v = 0; v < poly; ++v) e.noteOn(43 + 5 * v, 0.8f, 0);
+            }
+            static const Juno106::JunoPatch patches[] = {
+                makePatch(110, 30, 40, false),
+                makePatch(35, 100, 80, true),
+                makePatch(75, 60, 20, false),
+            };
+            forEachTick(start, start + frames, sr / 4, 0, [&](std::int64_t, std::int64_t k) {
+                e.loadPatch(patches[k % 3]);
+            });
+        }});
+
+    // Short stabs every 1.5 s with a 5 s release, so most of the time is
+    // overlapping release tails.
+    list.push_back({"release_tails",
+        [](JunoDSPEngine &e) { e.setParameter(ParamId::Release, 5.0f); },
+        [=](Timeline &e, std::int64_t start, int frames) {
+            forEachTick(start, start + frames, sr * 3 / 2, 0, [&](std::int64_t t, std::int64_t k) {
+                const int base = 45 + static_cast<int>(k % 3) * 2;
+                for (int v = 0; v < poly; ++v) {
+                    e.noteOn(base + 4 * v, 0.9f, t);
+                    e.noteOff(base + 4 * v, t + sr / 10);
+                }
+            });
+        }});
+    return list;
+}
+
+} // namespace engine_workloads
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal component microbenchmark harness for juno_microbench.
+//
+// A case is a callable that processes `samplesPerCall` samples (or other
+// units: a parser case counts patches). The harness calls it until at least
+// minSeconds have passed, repeats that kRepeats times and keeps the fastest
+// run, which is the least disturbed by the scheduler. Results go to a
+// table on stdout and to JSON for the perf dashboard.
+namespace microbench {
+
+// Keeps `value` (and the work producing it) from being optimised away.
+inline void doNotOptimize(float value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile float sink;
+    sink = value;
+#endif
+}
+
+struct Result {
+    std::string module;
+    std::string variant;      // parameter point, e.g. "cutoff=50 resonance=1"
+    std::string unit;         // what one "sample" is: "sample" or "patch"
+    int sampleRate = 0;       // 0 where the rate does not apply
+    std::int64_t samples = 0; // units processed by the fastest run
+    double nsPerSample = 0.0;
+    double samplesPerSec = 0.0;
+};
+
+class Runner {
+public:
+    static constexpr int kRepeats = 3;
+
+    explicit Runner(double minSeconds) : minSeconds_(minSeconds) {}
+
+    template <typename Fn>
+    void run(const std::string &module, const std::string &variant, int sampleRate,
+             int samplesPerCall, Fn &&fn, const char *unit = "sample") {
+        fn();   // warm caches and lazily sized state
+        Result r;
+        r.module = module;
+        r.variant = variant;
+        r.unit = unit;
+        r.sampleRate = sampleRate;
+        double best = 0.0;
+        for (int rep = 0; rep < kRepeats; ++rep) {
+            std::int64_t samples = 0;
+            const auto start = std::chrono::steady_clock::now();
+            double elapsed = 0.0;
+            do {
+                fn();
+                samples += samplesPerCall;
+                elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            } while (elapsed < minSeconds_);
+            const double ns = elapsed * 1e9 / static_cast<double>(samples);
+            if (rep == 0 || ns < best) {
+                best = ns;
+                r.samples = samples;
+            }
+        }
+        r.nsPerSample = best;
+        r.samplesPerSec = 1e9 / best;
+        results_.push_back(r);
+    }
+
+    const std::vector<Result> &results() const { return results_; }
+
+    void writeTable(std::ostream &os) const {
+        for (const auto &r : results_) {
+            os << r.module << " [" << r.variant << "]";
+            if (r.sampleRate > 0) os << " @" << r.sampleRate;
+            os << ": " << r.nsPerSample << " ns/" << r.unit << ", "
+               << r.samplesPerSec << " " << r.unit << "/s\n";
+        }
+    }
+
+    void writeJson(std::ostream &os) const {
+        os << "{\n  \"schema\": 1,\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const Result &r = results_[i];
+            os << (i ? ",\n" : "\n") << "    {\"module\": \"" << r.module
+               << "\", \"variant\": \"" << r.variant
+               << "\", \"unit\": \"" << r.unit
+               << "\", \"sample_rate\": " << r.sampleRate
+               << ", \"samples\": " << r.samples
+               << ", \"ns_per_sample\": " << r.nsPerSample
+               << ", \"samples_per_sec\": " << r.samplesPerSec << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+private:
+    double minSeconds_;
+    std::vector<Result> results_;
+};
+
+// Shortest round-trip text for a parameter value in a variant label.
+inline std::string format(float value) {
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
+
+// Sample rates every audio-rate case runs at.
+constexpr int kSampleRates[] = {44100, 48000, 96000};
+
+// Samples per call for the audio-rate cases: one typical host block.
+constexpr int kBlock = 256;
+
+// Deterministic test signal of about +-1: a saw with a little LCG noise, so
+// nonlinear stages see a full-scale, non-periodic input.
+inline std::vector<float> testSignal(int n) {
+    std::vector<float> x(static_cast<std::size_t>(n));
+    std::uint32_t seed = 1u;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = static_cast<float>(seed >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        x[static_cast<std::size_t>(i)] = 2.0f * static_cast<float>(i % 100) / 100.0f - 1.0f + 0.1f * noise;
+    }
+    return x;
+}
+
+// The two halves of the suite live in separate translation units: the rtn
+// (JunoDSPEngine) and analog (JunoEngine) trees both define a BBDChorus.
+void runRtnBenchmarks(Runner &runner);
+void runAnalogBenchmarks(Runner &runner);
+
+} // namespace microbench
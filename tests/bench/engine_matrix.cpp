@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "EngineWorkloads.hpp"
+#include "JunoDSPEngine.hpp"
+#include "Microbench.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+// juno_engine_matrix: JunoDSPEngine under scripted, realistic workloads.
+//
+//   juno_engine_matrix [--sr N] [--bs N] [--poly N] [--seconds S]
+//                      [--baseline file.csv [--tolerance T]]
+//                      [--update-baseline file.csv] [--json file]
+//
+// One run measures one (sample rate, buffer size, polyphony) cell, by
+// default the TEST_* cell CMake was configured with, so the dsp_matrix
+// workflow's matrix maps onto it directly. Every workload renders `seconds`
+// of audio after a short warm-up, timing each callback, and reports CPU
+// percent of realtime (total render time over audio time) and p50/p99/max
+// callback time, each the best of three runs. With --baseline the run fails
+// if a workload's CPU percent exceeds the baseline row for its cell by more
+// than the tolerance (a fraction, default 0.5); p99 is compared and
+// reported but not gated, and cells without a row only report. Each row
+// also records a reference kernel's speed, and limits scale by how fast
+// that kernel runs now, so clock drift and other runner classes do not trip
+// the gate while the engine's cost relative to the machine still does.
+// Baselines only transfer between machines of one runner class; record
+// them where the gate runs.
+// --update-baseline writes this cell's rows into the file instead.
+
+namespace {
+
+using engine_workloads::Timeline;
+using engine_workloads::Workload;
+using engine_workloads::workloads;
+
+struct Cell {
+    int sampleRate = TEST_SAMPLE_RATE;
+    int bufferSize = TEST_BUFFER_SIZE;
+    int polyphony  = TEST_POLYPHONY;
+};
+
+struct Stats {
+    std::string workload;
+    double cpuPercent = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double referenceNs = 0.0;   // reference kernel, ns/sample, next to this run
+};
+
+// A fixed scalar DSP loop (a saturating one-pole over a saw), the yardstick
+// for machine speed. A chunk runs after every timed callback, so it sees the
+// same clock speed and contention as the engine; returns its time in ns.
+class ReferenceKernel {
+public:
+    static constexpr int kChunk = 256;
+
+    double runChunk() {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kChunk; ++i) {
+            phase_ += 0.01f;
+            phase_ -= phase_ >= 1.0f ? 1.0f : 0.0f;
+            y_ += 0.1f * (2.0f * phase_ - 1.0f - y_) / (1.0f + std::fabs(y_));
+        }
+        microbench::doNotOptimize(y_);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+private:
+    float phase_ = 0.0f;
+    float y_ = 0.0f;
+};
+
+double percentile(std::vector<double> sorted, double q) {
+    std::sort(sorted.begin(), sorted.end());
+    const auto i = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+Stats run(const Workload &w, const Cell &cell, double seconds) {
+    constexpr int kWarmupBlocks = 20;
+    JunoDSPEngine engine;
+    engine.initialize(cell.sampleRate, cell.bufferSize, cell.polyphony, false);
+    engine.start();
+    w.setup(engine);
+
+    const int n = cell.bufferSize;
+    std::vector<float> left(static_cast<std::size_t>(n)), right(left.size());
+    for (int b = 0; b < kWarmupBlocks; ++b) engine.renderAudio(left.data(), right.data(), n);
+
+    Timeline timeline{engine, engine.currentSampleTime()};
+    const int blocks = std::max(1, static_cast<int>(seconds * cell.sampleRate / n));
+    std::vector<double> us;
+    us.reserve(static_cast<std::size_t>(blocks));
+    double totalUs = 0.0;
+    ReferenceKernel reference;
+    double referenceNs = 0.0;
+    for (int b = 0; b < blocks; ++b) {
+        const std::int64_t start = static_cast<std::int64_t>(b) * n;
+        w.script(timeline, start, n);
+        const auto t0 = std::chrono::steady_clock::now();
+        engine.renderAudio(left.data(), right.data(), n);
+        const auto t1 = std::chrono::steady_clock::now();
+        const double dt = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        us.push_back(dt);
+        totalUs += dt;
+        referenceNs += reference.runChunk();
+    }
+    engine.stop();
+
+    Stats s;
+    s.workload = w.name;
+    s.referenceNs = referenceNs / (static_cast<double>(blocks) * ReferenceKernel::kChunk);
+    s.cpuPercent = 100.0 * totalUs / (1e6 * blocks * n / cell.sampleRate);
+    s.p50Us = percentile(us, 0.50);
+    s.p99Us = percentile(us, 0.99);
+    s.maxUs = *std::max_element(us.begin(), us.end());
+    return s;
+}
+
+// Baseline rows:
+// workload,sample_rate,buffer_size,polyphony,cpu_percent,p99_us,reference_ns
+struct BaselineRow {
+    std::string workload;
+    int sampleRate = 0, bufferSize = 0, polyphony = 0;
+    double cpuPercent = 0.0, p99Us = 0.0, referenceNs = 0.0;
+    bool sameCell(const Cell &c) const {
+        return sampleRate == c.sampleRate && bufferSize == c.bufferSize && polyphony == c.polyphony;
+    }
+};
+
+std::vector<BaselineRow> readBaseline(const std::string &path, std::vector<std::string> *comments) {
+    std::vector<BaselineRow> rows;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            if (comments) comments->push_back(line);
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        BaselineRow r;
+        if (fields >> r.workload >> r.sampleRate >> r.bufferSize >> r.polyphony >> r.cpuPercent >> r.p99Us
+                   >> r.referenceNs) {
+            rows.push_back(r);
+        }
+    }
+    return rows;
+}
+
+void writeJson(const std::string &path, const Cell &cell, const std::vector<Stats> &stats) {
+    std::ofstream os(path);
+    os << "{\n  \"sample_rate\": " << cell.sampleRate << ",\n  \"buffer_size\": " << cell.bufferSize
+       << ",\n  \"polyphony\": " << cell.polyphony << ",\n  \"workloads\": [";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const Stats &s = stats[i];
+        os << (i ? ",\n" : "\n") << "    {\"workload\": \"" << s.workload
+           << "\", \"cpu_percent\": " << s.cpuPercent << ", \"p50_us\": " << s.p50Us
+           << ", \"p99_us\": " << s.p99Us << ", \"max_us\": " << s.maxUs
+           << ", \"reference_ns\": " << s.referenceNs << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    constexpr int kRepeats = 3;
+    Cell cell;
+    double seconds = 4.0;
+    double tolerance = 0.5;
+    std::string baselinePath, updatePath, jsonPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--sr" && hasValue) {
+            cell.sampleRate = std::atoi(argv[++i]);
+        } else if (arg == "--bs" && hasValue) {
+            cell.bufferSize = std::atoi(argv[++i]);
+        } else if (arg == "--poly" && hasValue) {
+            cell.polyphony = std::atoi(argv[++i]);
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        } else if (arg == "--update-baseline" && hasValue) {
+            updatePath = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--sr N] [--bs N] [--poly N] [--seconds S]"
+                      << " [--baseline file [--tolerance T]] [--update-baseline file] [--json file]\n";
+            return 2;
+        }
+    }
+
+    std::vector<Stats> stats;
+    for (const Workload &w : workloads(cell.sampleRate, cell.polyphony)) {
+        // Like microbench::Runner: the least disturbed of a few runs, which
+        // keeps scheduler noise on shared runners out of the gate.
+        Stats s = run(w, cell, seconds);
+        for (int rep = 1; rep < kRepeats; ++rep) {
+            const Stats again = run(w, cell, seconds);
+            s.cpuPercent = std::min(s.cpuPercent, again.cpuPercent);
+            s.p50Us = std::min(s.p50Us, again.p50Us);
+            s.p99Us = std::min(s.p99Us, again.p99Us);
+            s.maxUs = std::min(s.maxUs, again.maxUs);
+            s.referenceNs = std::min(s.referenceNs, again.referenceNs);
+        }
+        stats.push_back(s);
+        std::cout << "[METRIC] engine_matrix workload=" << s.workload << " sr=" << cell.sampleRate
+                  << " bs=" << cell.bufferSize << " poly=" << cell.polyphony
+                  << " cpu_percent=" << s.cpuPercent << " p50_us=" << s.p50Us
+                  << " p99_us=" << s.p99Us << " max_us=" << s.maxUs
+                  << " reference_ns=" << s.referenceNs << std::endl;
+    }
+
+    if (!jsonPath.empty()) writeJson(jsonPath, cell, stats);
+
+    if (!updatePath.empty()) {
+        std::vector<std::string> comments;
+        std::vector<BaselineRow> rows = readBaseline(updatePath, &comments);
+        rows.erase(std::remove_if(rows.begin(), rows.end(),
+                                  [&](const BaselineRow &r) { return r.sameCell(cell); }),
+                   rows.end());
+        for (const Stats &s : stats) {
+            rows.push_back({s.workload, cell.sampleRate, cell.bufferSize, cell.polyphony,
+                            s.cpuPercent, s.p99Us, s.referenceNs});
+        }
+        std::sort(rows.begin(), rows.end(), [](const BaselineRow &a, const BaselineRow &b) {
+            return std::tie(a.sampleRate, a.bufferSize, a.polyphony, a.workload) <
+                   std::tie(b.sampleRate, b.bufferSize, b.polyphony, b.workload);
+        });
+        std::ofstream out(updatePath);
+        for (const auto &c : comments) out << c << "\n";
+        for (const auto &r : rows) {
+            out << r.workload << "," << r.sampleRate << "," << r.bufferSize << ","
+                << r.polyphony << "," << r.cpuPercent << "," << r.p99Us << ","
+                << r.referenceNs << "\n";
+        }
+    }
+
+    if (baselinePath.empty()) return 0;
+
+    const std::vector<BaselineRow> baseline = readBaseline(baselinePath, nullptr);
+    int failures = 0;
+    for (const Stats &s : stats) {
+        const auto row = std::find_if(baseline.begin(), baseline.end(), [&](const BaselineRow &r) {
+            return r.workload == s.workload && r.sameCell(cell);
+        });
+        if (row == baseline.end()) {
+            std::cout << "no baseline for " << s.workload << " in this cell; not gated\n";
+            continue;
+        }
+        const double speed = s.referenceNs / row->referenceNs;
+        const double cpuLimit = row->cpuPercent * speed * (1.0 + tolerance);
+        if (s.cpuPercent > cpuLimit) {
+            std::cout << "REGRESSION " << s.workload << ": cpu_percent " << s.cpuPercent
+                      << " (limit " << cpuLimit << ")\n";
+            ++failures;
+        }
+        // Callback tails are mostly scheduler noise (a preemption costs
+        // more than a whole block), so p99 is reported against the
+        // baseline but never fails the run.
+        const double p99Scaled = row->p99Us * speed;
+        if (s.p99Us > p99Scaled * (1.0 + tolerance)) {
+            std::cout << "note " << s.workload << ": p99_us " << s.p99Us
+                      << " over baseline " << p99Scaled << " (not gated)\n";
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
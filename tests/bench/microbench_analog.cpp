@@ -0,0 +1,150 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Microbench.hpp"
+#include "dsp/AnalogModelTier.hpp"
+#include "dsp/BBDClockNoise.hpp"
+#include "dsp/Envelope.hpp"
+#include "dsp/IR3109OTA.hpp"
+#include "dsp/JFETVCA.hpp"
+#include "dsp/Oscillator.hpp"
+#include "dsp/PowerSupplySag.hpp"
+#include "parser/Juno106PatchParser.hpp"
+
+namespace {
+
+// `count` valid .106 sysex messages with varied slider values.
+std::vector<uint8_t> patchBank(int count) {
+    std::vector<uint8_t> bank;
+    for (int p = 0; p < count; ++p) {
+        uint8_t msg[Juno106::SYSEX_MESSAGE_SIZE] = {Juno106::SYSEX_START, Juno106::ROLAND_ID,
+                                                    0x30, static_cast<uint8_t>(p & 0x7F), 0x00};
+        uint32_t sum = 0;
+        for (int i = 5; i <= 22; ++i) {
+            msg[i] = static_cast<uint8_t>((p * 7 + i * 13) & 0x7F);
+            sum += msg[i];
+        }
+        msg[23] = static_cast<uint8_t>((128 - (sum & 0x7F)) & 0x7F);
+        msg[24] = Juno106::SYSEX_END;
+        bank.insert(bank.end(), msg, msg + Juno106::SYSEX_MESSAGE_SIZE);
+    }
+    return bank;
+}
+
+} // namespace
+
+// JunoEngine components (cpp/dsp, cpp/parser).
+void microbench::runAnalogBenchmarks(Runner &runner) {
+    const std::vector<float> input = testSignal(kBlock);
+    std::vector<float> out(input.size());
+
+    for (int sr : kSampleRates) {
+        const float rate = static_cast<float>(sr);
+
+        // The voice feeds the filter log2(Hz) * 0.1 as its cutoff CV.
+        for (float cutoff : {50.0f, 15000.0f}) {
+            for (float resonance : {0.0f, 1.0f}) {
+                const std::string point = "cutoff=" + format(cutoff) + " resonance=" + format(resonance);
+                const float cutoffCV = std::log2(cutoff) * 0.1f;
+                const std::pair<AnalogTier, const char *> tiers[] = {
+                    {AnalogTier::Eco, " tier=eco"},
+                    {AnalogTier::Standard, " tier=standard"},
+                    {AnalogTier::Ultra, " tier=ultra"},
+                };
+                for (const auto &tier : tiers) {
+                    IR3109Filter filter;
+                    filter.setSampleRate(rate);
+                    withAnalogTier(tier.first, [&](auto model) {
+                        using Model = decltype(model);
+                        const float current = filter.tailCurrent<Model>(cutoffCV, 0.5f);
+                        runner.run("IR3109Filter", point + tier.second, sr, kBlock, [&] {
+                            float acc = 0.0f;
+                            for (float x : input) {
+                                acc += filter.processCurrent<Model>(x, current, resonance);
+                            }
+                            doNotOptimize(acc);
+                        });
+                    });
+                }
+            }
+        }
+
+        for (float cv : {0.0f, 1.0f}) {
+            JFETVCA vca;
+            vca.setSampleRate(rate);
+            runner.run("JFETVCA", "cv=" + format(cv) + " per-sample bias", sr, kBlock, [&] {
+                float acc = 0.0f;
+                for (float x : input) acc += vca.process(x, cv);
+                doNotOptimize(acc);
+            });
+            const float bias = vca.bias(cv);
+            runner.run("JFETVCA", "cv=" + format(cv) + " cached bias", sr, kBlock, [&] {
+                float acc = 0.0f;
+                for (float x : input) acc += vca.processBiased(x, bias);
+                doNotOptimize(acc);
+            });
+        }
+
+        // Each call is a whole note: trigger, half a block, release.
+        for (float seconds : {0.0015f, 3.0f}) {
+            ExponentialADSR env;
+            env.setSampleRate(rate);
+            env.setTimes(seconds, seconds, 0.5f, seconds);
+            runner.run("ExponentialADSR", "times=" + format(seconds), sr, kBlock, [&] {
+                env.noteOn();
+                env.processBlock(out.data(), kBlock / 2);
+                env.noteOff();
+                env.processBlock(out.data() + kBlock / 2, kBlock / 2);
+                doNotOptimize(out[kBlock - 1]);
+            });
+        }
+
+        for (float freq : {32.7f, 4186.0f}) {
+            for (bool pwm : {false, true}) {
+                DCO dco;
+                dco.setSampleRate(rate);
+                const std::string point = "freq=" + format(freq) + (pwm ? " pwm=lfo" : " pwm=off");
+                runner.run("DCO", point, sr, kBlock, [&] {
+                    float acc = 0.0f;
+                    for (float x : input) acc += dco.process(freq, x, 1.0f, pwm, 1.0f);
+                    doNotOptimize(acc);
+                });
+            }
+        }
+
+        for (float jitter : {0.0f, 1.0f}) {
+            BBDClockNoise noise;
+            noise.setSampleRate(rate);
+            noise.setClockRate(15000.0f);
+            noise.setJitterAmount(jitter);
+            runner.run("BBDClockNoise", "jitter=" + format(jitter), sr, kBlock, [&] {
+                float acc = 0.0f;
+                for (int i = 0; i < kBlock; ++i) acc += noise.process();
+                doNotOptimize(acc);
+            });
+        }
+
+        for (int voices : {0, 6}) {
+            PowerSupplySag sag;
+            sag.setSampleRate(rate);
+            const float totalResonance = static_cast<float>(voices);
+            runner.run("PowerSupplySag", "voices=" + std::to_string(voices), sr, kBlock, [&] {
+                float acc = 0.0f;
+                for (int i = 0; i < kBlock; ++i) {
+                    sag.update(voices, totalResonance);
+                    acc += sag.outputComp();
+                }
+                doNotOptimize(acc);
+            });
+        }
+    }
+
+    for (int count : {1, 128}) {
+        const std::vector<uint8_t> bank = patchBank(count);
+        runner.run("PatchParser::parseBuffer", "patches=" + std::to_string(count), 0, count, [&] {
+            const auto patches = Juno106::PatchParser::parseBuffer(bank, 0);
+            doNotOptimize(static_cast<float>(patches.back().vcfCutoff));
+        }, "patch");
+    }
+}
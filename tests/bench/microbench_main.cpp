@@ -0,0 +1,43 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Microbench.hpp"
+
+// juno_microbench [--quick] [--json <path>]
+//
+// Times each DSP component per sample at every rate in kSampleRates and at
+// the extremes of its parameters, prints a table and, with --json, writes
+// the results for the perf dashboard. --quick shortens every run (CTest
+// uses it to check the suite still builds and runs).
+int main(int argc, char **argv) {
+    bool quick = false;
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--json <path>]\n";
+            return 2;
+        }
+    }
+
+    microbench::Runner runner(quick ? 0.002 : 0.05);
+    microbench::runRtnBenchmarks(runner);
+    microbench::runAnalogBenchmarks(runner);
+    runner.writeTable(std::cout);
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        runner.writeJson(json);
+        if (!json) {
+            std::cerr << "cannot write " << jsonPath << "\n";
+            return 1;
+        }
+        std::cout << "wrote " << runner.results().size() << " results to " << jsonPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <string>
+#include <vector>
+
+#include "BBDChorus.hpp"
+#include "Microbench.hpp"
+#include "NonlinearVCF.hpp"
+
+// JunoDSPEngine components (rtn-juno-engine/cpp/dsp).
+void microbench::runRtnBenchmarks(Runner &runner) {
+    const std::vector<float> input = testSignal(kBlock);
+    std::vector<float> buffer(input.size()), outL(input.size()), outR(input.size());
+
+    for (int sr : kSampleRates) {
+        for (float cutoff : {50.0f, 15000.0f}) {
+            for (float resonance : {0.0f, 1.2f}) {
+                const std::string point = "cutoff=" + format(cutoff) + " resonance=" + format(resonance);
+                NonlinearVCF vcf;
+                vcf.configure(static_cast<float>(sr));
+                runner.run("NonlinearVCF", point + " block", sr, kBlock, [&] {
+                    buffer = input;
+                    vcf.processBlock(buffer.data(), kBlock, cutoff, resonance);
+                    doNotOptimize(buffer[kBlock - 1]);
+                });
+                vcf.reset();
+                runner.run("NonlinearVCF", point + " per-sample", sr, kBlock, [&] {
+                    float acc = 0.0f;
+                    for (float x : input) acc += vcf.process(x, cutoff, resonance);
+                    doNotOptimize(acc);
+                });
+            }
+        }
+
+        const std::pair<BBDChorus::Mode, const char *> modes[] = {
+            {BBDChorus::Mode::I, "mode=I"},
+            {BBDChorus::Mode::II, "mode=II"},
+        };
+        for (const auto &mode : modes) {
+            BBDChorus chorus;
+            chorus.configure(static_cast<float>(sr));
+            chorus.setMode(mode.first);
+            runner.run("BBDChorus", mode.second, sr, kBlock, [&] {
+                chorus.processBlock(input.data(), outL.data(), outR.data(), kBlock);
+                doNotOptimize(outL[kBlock - 1] + outR[kBlock - 1]);
+            });
+        }
+    }
+}
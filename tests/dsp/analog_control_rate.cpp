@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "dsp/JunoVoice.hpp"
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+namespace {
+
+VoiceParams testParams() {
+    VoiceParams p;
+    p.cutoffHz = 800.0f;
+    p.envAttack = 0.02f;
+    p.envDecay = 0.3f;
+    p.envRelease = 0.2f;
+    return p;
+}
+
+} // namespace
+
+TEST(AnalogControlRate, AudioRateIsTheDefault) {
+    JunoVoice voice;
+    voice.init(0, TEST_SAMPLE_RATE);
+    EXPECT_EQ(voice.controlInterval(), 1);
+    EXPECT_EQ(JunoVoice::firmwareControlInterval(48000.0f), 192);
+}
+
+TEST(AnalogControlRate, EnvelopeTicksLandOnTheAudioRateCurve) {
+    const int interval = JunoVoice::firmwareControlInterval(TEST_SAMPLE_RATE);
+
+    JunoVoice audio;
+    JunoVoice firmware;
+    audio.init(0, TEST_SAMPLE_RATE);
+    firmware.init(0, TEST_SAMPLE_RATE);
+    firmware.setControlInterval(interval);
+    for (JunoVoice *v : {&audio, &firmware}) {
+        v->setParams(testParams());
+        v->noteOn(48, 1.0f);
+    }
+
+    // A tick evaluates the envelope one interval ahead; its value is reached
+    // by the interpolated CV on the tick's last sample.
+    float maxDiff = 0.0f;
+    const int samples = TEST_SAMPLE_RATE;
+    for (int i = 0; i < samples; ++i) {
+        if (i == samples / 2) {
+            audio.noteOff();
+            firmware.noteOff();
+        }
+        audio.processSample();
+        firmware.processSample();
+        if ((i + 1) % interval == 0) {
+            maxDiff = std::max(maxDiff, std::fabs(audio.envelopeLevel() - firmware.envelopeLevel()));
+        }
+    }
+    EXPECT_LT(maxDiff, 0.01f);
+}
+
+TEST(AnalogControlRate, FirmwareTickOutputTracksAudioRate) {
+    const int interval = JunoVoice::firmwareControlInterval(TEST_SAMPLE_RATE);
+
+    JunoVoice audio;
+    JunoVoice firmware;
+    audio.init(2, TEST_SAMPLE_RATE);
+    firmware.init(2, TEST_SAMPLE_RATE);
+    firmware.setControlInterval(interval);
+    for (JunoVoice *v : {&audio, &firmware}) {
+        v->setParams(testParams());
+        v->noteOn(57, 0.8f);
+    }
+
+    double maxDiff = 0.0;
+    double energy = 0.0;
+    for (int i = 0; i < TEST_SAMPLE_RATE / 2; ++i) {
+        const float a = audio.processSample();
+        const float f = firmware.processSample();
+        ASSERT_TRUE(std::isfinite(f));
+        maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(a - f)));
+        energy += static_cast<double>(a) * a;
+    }
+    const double rms = std::sqrt(energy / (TEST_SAMPLE_RATE / 2));
+    EXPECT_GT(rms, 0.0);
+    EXPECT_LT(maxDiff, 0.25 * rms);
+}
+
+TEST(AnalogControlRate, EngineRenderCost) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int blocks = 200;
+
+    auto run = [&](bool firmwareRate) {
+        JunoEngine engine;
+        engine.init(TEST_SAMPLE_RATE);
+        if (firmwareRate) engine.setFirmwareControlRate();
+        for (int n = 0; n < JunoEngine::VOICE_COUNT; ++n) engine.noteOn(48 + 3 * n, 0.8f);
+
+        std::vector<float> left(bufferSize), right(bufferSize);
+        engine.render(left.data(), right.data(), bufferSize);
+        const auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < blocks; ++b) {
+            engine.render(left.data(), right.data(), bufferSize);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        for (float s : left) EXPECT_TRUE(std::isfinite(s));
+        return std::chrono::duration<double, std::micro>(end - start).count() / blocks;
+    };
+
+    const double audioUs = run(false);
+    const double firmwareUs = run(true);
+    std::cout << "[METRIC] Analog block render audio-rate CV (us): " << audioUs
+              << " | firmware tick (us): " << firmwareUs << std::endl;
+
+    SUCCEED();
+}
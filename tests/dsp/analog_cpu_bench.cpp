@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "engine/JunoEngine.hpp"
+#include "realtime_factor.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+// The realtime_factor workload on the analog engine, per tier; compare with
+// the engine=rtn line from cpu_bench.cpp.
+TEST(AnalogCPU, RealtimeFactorWithHeldVoices) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    static_assert(realtime_factor::kVoices == JunoEngine::VOICE_COUNT,
+                  "the shared workload fills the analog engine");
+
+    const std::pair<AnalogTier, const char *> tiers[] = {
+        {AnalogTier::Eco, "analog_eco"},
+        {AnalogTier::Standard, "analog_standard"},
+        {AnalogTier::Ultra, "analog_ultra"},
+    };
+    for (const auto &tier : tiers) {
+        JunoEngine engine;
+        engine.init(sampleRate);
+        engine.setAnalogTier(tier.first);
+        for (int v = 0; v < realtime_factor::kVoices; ++v) {
+            engine.noteOn(realtime_factor::note(v), 0.8f);
+        }
+
+        const auto result = realtime_factor::measure(
+            [&](float *l, float *r, int n) { engine.render(l, r, n); }, sampleRate, bufferSize);
+        realtime_factor::report(tier.second, result, sampleRate, bufferSize);
+        EXPECT_GT(result.realtimeFactor, 0.0);
+    }
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "dsp/JunoVoice.hpp"
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+namespace {
+
+double voiceRms(int factor) {
+    VoiceParams p;
+    p.cutoffHz = 2000.0f;
+    p.resonance = 0.7f;
+    p.envAttack = 0.005f;
+    p.envSustain = 0.8f;
+
+    JunoVoice voice;
+    voice.init(0, TEST_SAMPLE_RATE);
+    voice.setOversampling(factor);
+    voice.setParams(p);
+    voice.noteOn(57, 0.9f);
+    double energy = 0.0;
+    const int samples = TEST_SAMPLE_RATE / 2;
+    for (int i = 0; i < samples; ++i) {
+        const float s = voice.processSample();
+        EXPECT_TRUE(std::isfinite(s));
+        energy += static_cast<double>(s) * s;
+    }
+    return std::sqrt(energy / samples);
+}
+
+} // namespace
+
+TEST(AnalogOversampling, FilterAndVCAKeepTheirLevel) {
+    const double base = voiceRms(1);
+    ASSERT_GT(base, 0.0);
+    for (int factor : {2, 4}) {
+        const double db = 20.0 * std::log10(voiceRms(factor) / base);
+        EXPECT_LT(std::fabs(db), 1.5) << "factor " << factor;
+    }
+}
+
+TEST(AnalogOversampling, EngineCostAndLatency) {
+    constexpr int blocks = 100;
+    double baseUs = 0.0;
+    for (int factor : {1, 2, 4}) {
+        JunoEngine engine;
+        engine.init(TEST_SAMPLE_RATE);
+        engine.setOversampling(factor);
+        for (int n = 0; n < JunoEngine::VOICE_COUNT; ++n) engine.noteOn(48 + 3 * n, 0.8f);
+
+        std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+        engine.render(left.data(), right.data(), TEST_BUFFER_SIZE);
+        const auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < blocks; ++b) {
+            engine.render(left.data(), right.data(), TEST_BUFFER_SIZE);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        for (float s : left) EXPECT_TRUE(std::isfinite(s));
+        const double us = std::chrono::duration<double, std::micro>(end - start).count() / blocks;
+        if (factor == 1) baseUs = us;
+        std::cout << "[METRIC] Analog oversampling " << factor << "x block (us): " << us
+                  << " | cost vs 1x: " << us / baseUs
+                  << " | latency (frames): " << JunoEngine::oversamplingLatency(factor) << std::endl;
+    }
+    SUCCEED();
+}
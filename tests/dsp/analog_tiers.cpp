@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "dsp/AnalogModelTier.hpp"
+#include "dsp/JunoVoice.hpp"
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+namespace {
+
+VoiceParams testParams() {
+    VoiceParams p;
+    p.cutoffHz = 1200.0f;
+    p.resonance = 0.5f;
+    p.envAttack = 0.01f;
+    p.envDecay = 0.3f;
+    p.envRelease = 0.2f;
+    return p;
+}
+
+template <typename Model>
+std::vector<float> renderVoice(int samples) {
+    JunoVoice voice;
+    voice.init(1, TEST_SAMPLE_RATE);
+    voice.setParams(testParams());
+    voice.noteOn(52, 0.9f);
+    std::vector<float> out(static_cast<std::size_t>(samples));
+    for (int i = 0; i < samples; ++i) {
+        if (i == samples * 3 / 4) voice.noteOff();
+        out[static_cast<std::size_t>(i)] = voice.processSample<Model>();
+    }
+    return out;
+}
+
+double relativeError(const std::vector<float>& reference, const std::vector<float>& test) {
+    double diff = 0.0;
+    double energy = 0.0;
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        const double d = static_cast<double>(reference[i]) - test[i];
+        diff += d * d;
+        energy += static_cast<double>(reference[i]) * reference[i];
+    }
+    return energy > 0.0 ? std::sqrt(diff / energy) : 0.0;
+}
+
+} // namespace
+
+TEST(AnalogTiers, ApproximationsStayWithinTheirDocumentedErrors) {
+    float standardTanh = 0.0f;
+    float ecoTanh = 0.0f;
+    for (float x = -10.0f; x <= 10.0f; x += 0.001f) {
+        const float ref = std::tanh(x);
+        standardTanh = std::max(standardTanh, std::fabs(StandardModel::tanh(x) - ref));
+        ecoTanh = std::max(ecoTanh, std::fabs(EcoModel::tanh(x) - ref));
+    }
+    double ecoExp = 0.0;
+    for (float x = -80.0f; x <= 80.0f; x += 0.01f) {
+        const double ref = std::exp(static_cast<double>(x));
+        ecoExp = std::max(ecoExp, std::fabs(EcoModel::exp(x) / ref - 1.0));
+    }
+    std::cout << "[METRIC] analog_tier_max_error standard_tanh=" << standardTanh
+              << " eco_tanh=" << ecoTanh << " eco_exp_rel=" << ecoExp << std::endl;
+    EXPECT_LT(standardTanh, 1.5e-4f);
+    EXPECT_LT(ecoTanh, 0.025f);
+    EXPECT_LT(ecoExp, 2e-4);
+}
+
+TEST(AnalogTiers, UltraIsTheDefaultModel) {
+    const int samples = TEST_SAMPLE_RATE / 4;
+    JunoVoice voice;
+    voice.init(1, TEST_SAMPLE_RATE);
+    voice.setParams(testParams());
+    voice.noteOn(52, 0.9f);
+    const std::vector<float> ultra = renderVoice<UltraModel>(samples);
+    for (int i = 0; i < samples; ++i) {
+        ASSERT_EQ(voice.processSample(), ultra[static_cast<std::size_t>(i)]) << "sample " << i;
+    }
+}
+
+TEST(AnalogTiers, CheaperTiersTrackUltra) {
+    const int samples = TEST_SAMPLE_RATE / 2;
+    const std::vector<float> ultra = renderVoice<UltraModel>(samples);
+    const double standard = relativeError(ultra, renderVoice<StandardModel>(samples));
+    const double eco = relativeError(ultra, renderVoice<EcoModel>(samples));
+    std::cout << "[METRIC] analog_tier_rms_error_vs_ultra standard=" << standard
+              << " eco=" << eco << std::endl;
+    EXPECT_LT(standard, 0.01);
+    EXPECT_LT(eco, 0.1);
+}
+
+TEST(AnalogTiers, SwitchingTiersMidNoteIsSeamless) {
+    JunoEngine engine;
+    engine.init(TEST_SAMPLE_RATE);
+    engine.noteOn(45, 0.9f);
+
+    std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+    float last = 0.0f;
+    float maxStep = 0.0f;
+    float switchStep = 0.0f;
+    const AnalogTier order[] = {AnalogTier::Ultra, AnalogTier::Eco, AnalogTier::Standard,
+                                AnalogTier::Ultra};
+    for (int b = 0; b < 40; ++b) {
+        if (b >= 10 && b % 10 == 0) engine.setAnalogTier(order[b / 10]);
+        engine.render(left.data(), right.data(), TEST_BUFFER_SIZE);
+        for (int i = 0; i < TEST_BUFFER_SIZE; ++i) {
+            ASSERT_TRUE(std::isfinite(left[static_cast<std::size_t>(i)]));
+            const float step = std::fabs(left[static_cast<std::size_t>(i)] - last);
+            last = left[static_cast<std::size_t>(i)];
+            if (b == 0 && i == 0) continue;
+            if (i == 0 && b % 10 == 0) {
+                switchStep = std::max(switchStep, step);
+            } else {
+                maxStep = std::max(maxStep, step);
+            }
+        }
+    }
+    ASSERT_GT(maxStep, 0.0f);
+    EXPECT_LE(switchStep, maxStep);
+}
+
+TEST(AnalogTiers, EngineRenderCost) {
+    constexpr int blocks = 200;
+    auto run = [](AnalogTier tier) {
+        JunoEngine engine;
+        engine.init(TEST_SAMPLE_RATE);
+        engine.setAnalogTier(tier);
+        for (int n = 0; n < JunoEngine::VOICE_COUNT; ++n) engine.noteOn(48 + 3 * n, 0.8f);
+
+        std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+        engine.render(left.data(), right.data(), TEST_BUFFER_SIZE);
+        const auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < blocks; ++b) {
+            engine.render(left.data(), right.data(), TEST_BUFFER_SIZE);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / blocks;
+    };
+
+    const double ultraUs = run(AnalogTier::Ultra);
+    const double standardUs = run(AnalogTier::Standard);
+    const double ecoUs = run(AnalogTier::Eco);
+    std::cout << "[METRIC] Analog block render by tier (us): ultra " << ultraUs
+              << " | standard " << standardUs << " | eco " << ecoUs << std::endl;
+
+    SUCCEED();
+}
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "JunoDSPEngine.hpp"
+#include "realtime_factor.hpp"
 
 #ifndef TEST_SAMPLE_RATE
 #define TEST_SAMPLE_RATE 44100
@@ -59,3 +60,21 @@ TEST(CPU, AverageRenderSpeed) {
 
     SUCCEED();
 }
+
+TEST(CPU, RealtimeFactorWithHeldVoices) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+
+    JunoDSPEngine engine;
+    ASSERT_TRUE(engine.initialize(sampleRate, bufferSize, realtime_factor::kVoices, false));
+    engine.start();
+    for (int v = 0; v < realtime_factor::kVoices; ++v) {
+        engine.noteOn(realtime_factor::note(v), 0.8f);
+    }
+
+    const auto result = realtime_factor::measure(
+        [&](float *l, float *r, int n) { engine.renderAudio(l, r, n); }, sampleRate, bufferSize);
+    realtime_factor::report("rtn", result, sampleRate, bufferSize);
+    engine.stop();
+    EXPECT_GT(result.realtimeFactor, 0.0);
+}
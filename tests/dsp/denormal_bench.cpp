@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "DenormalGuard.hpp"
+#include "JunoDSPEngine.hpp"
+#include "NonlinearVCF.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+struct TailTiming {
+    double avgUs = 0.0;
+    double maxUs = 0.0;
+};
+
+// Times each block of a filter ringing out from a single burst. The four
+// stage states decay geometrically and reach the denormal range within a
+// few thousand samples.
+TailTiming filterTail(bool flush) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int blocks = 8 * TEST_SAMPLE_RATE / bufferSize;
+
+    const DenormalGuard denormals(flush);
+    NonlinearVCF filter;
+    filter.configure(TEST_SAMPLE_RATE);
+    std::vector<float> buffer(bufferSize, 0.0f);
+    std::fill(buffer.begin(), buffer.begin() + 16, 1.0f);
+
+    TailTiming t;
+    for (int b = 0; b < blocks; ++b) {
+        const auto start = std::chrono::steady_clock::now();
+        filter.processBlock(buffer.data(), bufferSize, 300.0f, 0.0f);
+        const auto end = std::chrono::steady_clock::now();
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        t.avgUs += us / blocks;
+        t.maxUs = std::max(t.maxUs, us);
+    }
+    return t;
+}
+
+// Times every block of a full-engine release tail, from note-off until the
+// engine reports silence plus a few seconds of idle.
+TailTiming engineTail(bool flush) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int blocks = 4 * TEST_SAMPLE_RATE / bufferSize;
+
+    JunoDSPEngine engine;
+    engine.setFlushDenormals(flush);
+    engine.initialize(TEST_SAMPLE_RATE, bufferSize, TEST_POLYPHONY, false);
+    engine.setParameter(ParamId::Release, 2.0f);
+    for (int v = 0; v < TEST_POLYPHONY; ++v) engine.noteOn(40 + 3 * v, 0.8f);
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    for (int b = 0; b < 32; ++b) engine.renderAudio(left.data(), right.data(), bufferSize);
+    for (int v = 0; v < TEST_POLYPHONY; ++v) engine.noteOff(40 + 3 * v);
+
+    TailTiming t;
+    for (int b = 0; b < blocks; ++b) {
+        const auto start = std::chrono::steady_clock::now();
+        engine.renderAudio(left.data(), right.data(), bufferSize);
+        const auto end = std::chrono::steady_clock::now();
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        t.avgUs += us / blocks;
+        t.maxUs = std::max(t.maxUs, us);
+    }
+    return t;
+}
+
+} // namespace
+
+TEST(Denormals, GuardFlushesAndRestores) {
+    if (!DenormalGuard::supported()) {
+        GTEST_SKIP() << "no flush-to-zero control on this target";
+    }
+
+    volatile float tiny = 1e-30f;
+    const bool wasActive = DenormalGuard::active();
+    {
+        const DenormalGuard denormals;
+        EXPECT_TRUE(DenormalGuard::active());
+        EXPECT_EQ(tiny * 1e-10f, 0.0f);
+        {
+            // Nested guards restore the outer mode, not the default.
+            const DenormalGuard off(false);
+            EXPECT_TRUE(DenormalGuard::active());
+        }
+        EXPECT_TRUE(DenormalGuard::active());
+    }
+    EXPECT_EQ(DenormalGuard::active(), wasActive);
+    if (!wasActive) {
+        EXPECT_GT(tiny * 1e-10f, 0.0f);
+    }
+}
+
+TEST(Denormals, ReleaseTailBenchmark) {
+    // Alternate the runs so drift in machine load hits both alike.
+    filterTail(true);
+    const TailTiming filterOff = filterTail(false);
+    const TailTiming filterOn  = filterTail(true);
+    const TailTiming engineOff = engineTail(false);
+    const TailTiming engineOn  = engineTail(true);
+
+    std::cout << "[METRIC] VCF release tail without FTZ avg/max (us): " << filterOff.avgUs
+              << " / " << filterOff.maxUs << " | with FTZ: " << filterOn.avgUs
+              << " / " << filterOn.maxUs << std::endl;
+    std::cout << "[METRIC] Engine release tail without FTZ avg/max (us): " << engineOff.avgUs
+              << " / " << engineOff.maxUs << " | with FTZ: " << engineOn.avgUs
+              << " / " << engineOn.maxUs << std::endl;
+
+    // A bare filter tail runs several times slower on denormals, so the
+    // guarded run must win by a margin no scheduling noise covers. The
+    // engine figures are reported only: voices retire at -80 dB, before
+    // their filters reach the denormal range.
+    if (DenormalGuard::supported()) {
+        EXPECT_LT(filterOn.avgUs * 1.5, filterOff.avgUs);
+    }
+}
@@ -0,0 +1,105 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoVoice.hpp"
+#include "VoiceBank.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+namespace {
+
+// Renders `seconds` of voice 0 of a one-voice bank and returns its
+// envelope level at the end.
+float runBank(VoiceBank &bank, float seconds) {
+    const std::size_t stride = TEST_BUFFER_SIZE;
+    std::vector<float> scratch(stride * VoiceBank::kLanes, 0.0f);
+    const int blocks = static_cast<int>(seconds * TEST_SAMPLE_RATE) / TEST_BUFFER_SIZE;
+    for (int b = 0; b < blocks; ++b) {
+        bank.renderGroup(0, scratch.data(), nullptr, stride, TEST_BUFFER_SIZE);
+    }
+    return bank.envelopeLevel(0);
+}
+
+} // namespace
+
+TEST(Envelope, DecaysToTheSustainLevelAndReleasesFromIt) {
+    VoiceBank bank;
+    bank.initialize(TEST_SAMPLE_RATE, 1, TEST_BUFFER_SIZE);
+    bank.setParam(ParamId::Attack, 0.005f);
+    bank.setParam(ParamId::Decay, 0.05f);
+    bank.setParam(ParamId::Sustain, 0.4f);
+    bank.setParam(ParamId::Release, 0.05f);
+    bank.noteOn(0, 60, 1.0f);
+
+    // The attack peaks before the decay takes over.
+    float peak = 0.0f;
+    for (int b = 0; b < 8; ++b) peak = std::max(peak, runBank(bank, 0.003f));
+    EXPECT_GT(peak, 0.9f);
+
+    EXPECT_NEAR(runBank(bank, 0.5f), 0.4f, 1e-4f);
+
+    // A sustain change moves a held note to the new level.
+    bank.setParam(ParamId::Sustain, 0.7f);
+    EXPECT_NEAR(runBank(bank, 0.5f), 0.7f, 1e-4f);
+
+    bank.noteOff(0, 60);
+    runBank(bank, 1.0f);
+    EXPECT_FALSE(bank.isActive(0));
+}
+
+TEST(Envelope, ZeroSustainRetiresTheVoiceWhileHeld) {
+    VoiceBank bank;
+    bank.initialize(TEST_SAMPLE_RATE, 1, TEST_BUFFER_SIZE);
+    bank.setParam(ParamId::Decay, 0.02f);
+    bank.setParam(ParamId::Sustain, 0.0f);
+    bank.noteOn(0, 60, 1.0f);
+    runBank(bank, 1.0f);
+    EXPECT_FALSE(bank.isActive(0));
+}
+
+TEST(Envelope, ReleaseChangesApplyToReleasingVoices) {
+    VoiceBank bank;
+    bank.initialize(TEST_SAMPLE_RATE, 1, TEST_BUFFER_SIZE);
+    bank.setParam(ParamId::Release, 5.0f);
+    bank.noteOn(0, 60, 1.0f);
+    runBank(bank, 0.2f);
+    bank.noteOff(0, 60);
+    runBank(bank, 0.1f);
+    EXPECT_TRUE(bank.isActive(0));
+
+    bank.setParam(ParamId::Release, 0.01f);
+    runBank(bank, 0.3f);
+    EXPECT_FALSE(bank.isActive(0));
+}
+
+TEST(Envelope, ScalarVoiceFollowsTheSameSegments) {
+    VoiceBank bank;
+    JunoVoice voice;
+    bank.initialize(TEST_SAMPLE_RATE, 1, TEST_BUFFER_SIZE);
+    voice.initialize(TEST_SAMPLE_RATE);
+    bank.setParam(ParamId::Decay, 0.05f);
+    bank.setParam(ParamId::Sustain, 0.5f);
+    voice.setParam("decay", 0.05f);
+    voice.setParam("sustain", 0.5f);
+    bank.noteOn(0, 48, 1.0f);
+    voice.noteOn(48, 1.0f);
+
+    std::vector<float> l(TEST_BUFFER_SIZE), r(TEST_BUFFER_SIZE);
+    float maxDiff = 0.0f;
+    for (int b = 0; b < 200; ++b) {
+        runBank(bank, static_cast<float>(TEST_BUFFER_SIZE) / TEST_SAMPLE_RATE);
+        voice.renderBlock(l.data(), r.data(), TEST_BUFFER_SIZE);
+        maxDiff = std::max(maxDiff, std::fabs(bank.envelopeLevel(0) - voice.envelopeLevel()));
+    }
+    std::cout << "[METRIC] envelope_scalar_vs_lanes_max_diff=" << maxDiff << std::endl;
+    EXPECT_LT(maxDiff, 1e-6f);
+    EXPECT_NEAR(voice.envelopeLevel(), 0.5f, 1e-4f);
+}
@@ -0,0 +1,139 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "FastMath.hpp"
+
+// Built with optimisation (see CMakeLists.txt) so the throughput numbers
+// compare inlined kernels with libm, as in the engine.
+
+namespace {
+
+// Calls fn on every float in [lo, hi] whose low `skipBits` mantissa bits
+// are zero: every exponent and every polynomial segment, at 2^(23 -
+// skipBits) points per octave.
+template <typename Fn>
+void sweep(float lo, float hi, int skipBits, Fn &&fn) {
+    const std::uint32_t step = 1u << skipBits;
+    for (std::uint64_t bits = 0; bits < 0x7f800000u; bits += step) {
+        float x;
+        const std::uint32_t b = static_cast<std::uint32_t>(bits);
+        std::memcpy(&x, &b, sizeof(x));
+        if (x >= lo && x <= hi) fn(x);
+        if (x != 0.0f && -x >= lo && -x <= hi) fn(-x);
+    }
+}
+
+template <typename Fn>
+double nsPerValue(const std::vector<float> &in, Fn &&fn) {
+    constexpr int kReps = 200;
+    std::vector<float> out(in.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kReps; ++r) {
+        for (std::size_t i = 0; i < in.size(); ++i) out[i] = fn(in[i]);
+#if defined(__GNUC__)
+        // Keep each pass: the inputs repeat, so the reps could be folded.
+        asm volatile("" : : "r"(out.data()) : "memory");
+#endif
+    }
+    const auto end = std::chrono::steady_clock::now();
+    volatile float sink = out[in.size() / 2];
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(kReps) * in.size());
+}
+
+} // namespace
+
+TEST(FastMath, Exp2RelativeError) {
+    double worst = 0.0;
+    sweep(-126.0f, 127.0f, 8, [&](float x) {
+        const double ref = std::exp2(static_cast<double>(x));
+        worst = std::max(worst, std::fabs(fastmath::exp2(x) / ref - 1.0));
+    });
+    std::cout << "[METRIC] fastmath_exp2_max_rel_error=" << worst << std::endl;
+    EXPECT_LT(worst, 2.5e-7);
+    EXPECT_EQ(fastmath::exp2(0.0f), 1.0f);
+    EXPECT_EQ(fastmath::exp2(-1000.0f), fastmath::exp2(-126.0f));
+    EXPECT_TRUE(std::isfinite(fastmath::exp2(1000.0f)));
+}
+
+TEST(FastMath, ExpRelativeError) {
+    double worst = 0.0;
+    sweep(-87.0f, 88.0f, 8, [&](float x) {
+        const double ref = std::exp(static_cast<double>(x));
+        const double bound = 2.5e-7 + 1e-7 * std::fabs(x);
+        worst = std::max(worst, std::fabs(fastmath::exp(x) / ref - 1.0) / bound);
+    });
+    std::cout << "[METRIC] fastmath_exp_max_error_vs_bound=" << worst << std::endl;
+    EXPECT_LT(worst, 1.0);
+}
+
+TEST(FastMath, Log2AbsoluteError) {
+    double worst = 0.0;
+    sweep(1.17549435e-38f, 3.4e38f, 8, [&](float x) {
+        const double ref = std::log2(static_cast<double>(x));
+        const double bound = 2e-7 + 6e-8 * std::fabs(ref);
+        worst = std::max(worst, std::fabs(fastmath::log2(x) - ref) / bound);
+    });
+    std::cout << "[METRIC] fastmath_log2_max_error_vs_bound=" << worst << std::endl;
+    EXPECT_LT(worst, 1.0);
+    EXPECT_EQ(fastmath::log2(0.0f), -126.0f);
+}
+
+TEST(FastMath, TanhAbsoluteError) {
+    double worst = 0.0;
+    sweep(-20.0f, 20.0f, 7, [&](float x) {
+        const double ref = std::tanh(static_cast<double>(x));
+        worst = std::max(worst, std::fabs(fastmath::tanh(x) - ref));
+    });
+    std::cout << "[METRIC] fastmath_tanh_max_abs_error=" << worst << std::endl;
+    EXPECT_LT(worst, 2.5e-7);
+    EXPECT_EQ(fastmath::tanh(0.0f), 0.0f);
+    EXPECT_EQ(fastmath::tanh(50.0f), 1.0f);
+    EXPECT_EQ(fastmath::tanh(-50.0f), -1.0f);
+}
+
+TEST(FastMath, SinAbsoluteError) {
+    constexpr double kTwoPi = 6.283185307179586;
+    double worst = 0.0;
+    sweep(-4.0f, 4.0f, 7, [&](float t) {
+        worst = std::max(worst, std::fabs(fastmath::sin2pi(t) - std::sin(kTwoPi * t)));
+    });
+    std::cout << "[METRIC] fastmath_sin2pi_max_abs_error=" << worst << std::endl;
+    EXPECT_LT(worst, 2.5e-7);
+
+    double worstSin = 0.0;
+    sweep(-1000.0f, 1000.0f, 8, [&](float x) {
+        const double err = std::fabs(fastmath::sin(x) - std::sin(static_cast<double>(x)));
+        worstSin = std::max(worstSin, err / (2.5e-7 + 1.2e-7 * std::fabs(x)));
+    });
+    std::cout << "[METRIC] fastmath_sin_max_error_vs_bound=" << worstSin << std::endl;
+    EXPECT_LT(worstSin, 1.0);
+}
+
+TEST(FastMath, Throughput) {
+    std::vector<float> in(4096);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = -4.0f + 8.0f * static_cast<float>(i) / static_cast<float>(in.size());
+    }
+    auto report = [&](const char *name, double libm, double fast) {
+        std::cout << "[METRIC] fastmath_" << name << " libm_ns=" << libm << " fast_ns=" << fast
+                  << " speedup=" << libm / fast << std::endl;
+    };
+    report("exp2", nsPerValue(in, [](float x) { return std::exp2(x); }),
+           nsPerValue(in, [](float x) { return fastmath::exp2(x); }));
+    report("exp", nsPerValue(in, [](float x) { return std::exp(x); }),
+           nsPerValue(in, [](float x) { return fastmath::exp(x); }));
+    report("log2", nsPerValue(in, [](float x) { return std::log2(x + 4.5f); }),
+           nsPerValue(in, [](float x) { return fastmath::log2(x + 4.5f); }));
+    report("tanh", nsPerValue(in, [](float x) { return std::tanh(x); }),
+           nsPerValue(in, [](float x) { return fastmath::tanh(x); }));
+    report("sin", nsPerValue(in, [](float x) { return std::sin(x); }),
+           nsPerValue(in, [](float x) { return fastmath::sin(x); }));
+    SUCCEED();
+}
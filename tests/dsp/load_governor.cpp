@@ -0,0 +1,194 @@
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "LoadGovernor.hpp"
+#include "VoiceAllocator.hpp"
+#include "VoiceBank.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+// Feeds `blocks` callbacks at `load` and returns how many changed the level.
+int feed(LoadGovernor &gov, float load, int blocks) {
+    int changes = 0;
+    for (int b = 0; b < blocks; ++b) {
+        changes += gov.update(load * 0.001, 0.001) ? 1 : 0;
+    }
+    return changes;
+}
+
+} // namespace
+
+TEST(LoadGovernor, SustainedOverloadDegradesOneLevelAtATime) {
+    LoadGovernor gov;
+    gov.configure({}, 3);
+    int blocks = 0;
+    while (gov.level() == 0 && blocks < 100) {
+        feed(gov, 0.9f, 1);
+        ++blocks;
+    }
+    EXPECT_EQ(gov.level(), 1);
+    EXPECT_GE(blocks, LoadGovernor::Config{}.degradeBlocks);
+    EXPECT_LT(blocks, 20);
+
+    feed(gov, 0.9f, 1000);
+    EXPECT_EQ(gov.level(), 3) << "never goes past maxLevel";
+}
+
+TEST(LoadGovernor, SingleLateCallbackDegradesAtOnce) {
+    LoadGovernor gov;
+    gov.configure({}, 2);
+    EXPECT_TRUE(gov.update(0.0012, 0.001));
+    EXPECT_EQ(gov.level(), 1);
+}
+
+TEST(LoadGovernor, RestoresOnlyAfterALongRunOfHeadroom) {
+    const LoadGovernor::Config config;
+    LoadGovernor gov;
+    gov.configure(config, 2);
+    feed(gov, 2.0f, 2);
+    ASSERT_EQ(gov.level(), 2);
+
+    // Between the thresholds nothing moves.
+    EXPECT_EQ(feed(gov, 0.6f, 2000), 0);
+    EXPECT_EQ(gov.level(), 2);
+
+    int blocks = 0;
+    while (gov.level() == 2 && blocks < 10000) {
+        feed(gov, 0.1f, 1);
+        ++blocks;
+    }
+    EXPECT_EQ(gov.level(), 1);
+    EXPECT_GE(blocks, config.restoreBlocks);
+}
+
+TEST(LoadGovernor, LoadAroundTheDegradeThresholdDoesNotFlap) {
+    LoadGovernor gov;
+    gov.configure({}, 4);
+    int changes = 0;
+    for (int b = 0; b < 5000; ++b) {
+        changes += feed(gov, (b % 2) ? 0.85f : 0.65f, 1);
+    }
+    // It may settle lower, but every step down must stick.
+    EXPECT_LE(changes, gov.maxLevel());
+}
+
+TEST(VoiceAllocator, LimitParksAndSilencesVoicesAboveIt) {
+    VoiceAllocator alloc;
+    alloc.initialize(6);
+    for (int n = 0; n < 6; ++n) alloc.noteOn(60 + n);
+    alloc.noteOff(65);
+
+    std::vector<int> silenced;
+    alloc.setLimit(4, [&](int v) { silenced.push_back(v); });
+    EXPECT_EQ(alloc.limit(), 4);
+    EXPECT_EQ(silenced, (std::vector<int>{4, 5}));
+    EXPECT_EQ(alloc.heldCount(), 4);
+    EXPECT_EQ(alloc.noteOff(64), -1) << "parked voice must not take the note-off";
+
+    // Full: steals among the first four only.
+    for (int n = 0; n < 8; ++n) {
+        EXPECT_LT(alloc.noteOn(70 + n), 4);
+    }
+
+    silenced.clear();
+    alloc.setLimit(6, [&](int v) { silenced.push_back(v); });
+    EXPECT_TRUE(silenced.empty());
+    EXPECT_EQ(alloc.freeCount(), 2);
+    const int v = alloc.noteOn(80);
+    EXPECT_GE(v, 4);
+}
+
+TEST(AdaptiveQuality, EngineShedsQualityAndVoicesUnderLoad) {
+    // Thresholds of zero make every callback count as overloaded.
+    LoadGovernor::Config config;
+    config.degradeLoad = 0.0f;
+    config.panicLoad = 0.0f;
+    config.degradeBlocks = 1;
+
+    JunoDSPEngine engine;
+    engine.setAdaptiveQuality(true, config);
+    ASSERT_TRUE(engine.initialize(TEST_SAMPLE_RATE, TEST_BUFFER_SIZE, TEST_POLYPHONY, false));
+    engine.start();
+    for (int n = 0; n < TEST_POLYPHONY; ++n) engine.noteOn(48 + n, 0.8f);
+
+    std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+    float peak = 0.0f;
+    for (int b = 0; b < 200; ++b) {
+        engine.renderAudio(left.data(), right.data(), TEST_BUFFER_SIZE);
+        for (float s : left) peak = std::max(peak, std::fabs(s));
+    }
+
+    const int lanes = VoiceBank::kLanes;
+    const int minVoices = std::min(TEST_POLYPHONY, lanes);
+    const int expected = 1 + (TEST_POLYPHONY - minVoices + lanes - 1) / lanes;
+    EXPECT_EQ(engine.qualityLevel(), expected);
+    EXPECT_GT(engine.renderLoad(), 0.0f);
+    EXPECT_GT(peak, 0.01f) << "the voices under the limit keep playing";
+    engine.stop();
+}
+
+TEST(AdaptiveQuality, OffByDefault) {
+    JunoDSPEngine engine;
+    ASSERT_TRUE(engine.initialize(TEST_SAMPLE_RATE, TEST_BUFFER_SIZE, TEST_POLYPHONY, false));
+    engine.start();
+    engine.noteOn(60, 0.8f);
+    std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+    for (int b = 0; b < 50; ++b) {
+        engine.renderAudio(left.data(), right.data(), TEST_BUFFER_SIZE);
+    }
+    EXPECT_EQ(engine.qualityLevel(), 0);
+    EXPECT_EQ(engine.renderLoad(), 0.0f);
+    engine.stop();
+}
+
+TEST(AdaptiveQuality, EcoFilterCost) {
+    constexpr int kBlocks = 2000;
+    auto run = [](VoiceBank::Quality quality, std::vector<float> &out) {
+        VoiceBank bank;
+        bank.initialize(TEST_SAMPLE_RATE, VoiceBank::kLanes, TEST_BUFFER_SIZE);
+        bank.setQuality(quality);
+        bank.setParam(ParamId::Resonance, 0.6f);
+        for (int v = 0; v < VoiceBank::kLanes; ++v) bank.noteOn(v, 48 + 7 * v, 0.8f);
+
+        const std::size_t stride = TEST_BUFFER_SIZE;
+        std::vector<float> left(stride * VoiceBank::kLanes), right(left.size());
+        out.clear();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int b = 0; b < kBlocks; ++b) {
+            bank.renderGroup(0, left.data(), right.data(), stride, TEST_BUFFER_SIZE);
+            if (b < 20) out.insert(out.end(), left.begin(), left.begin() + TEST_BUFFER_SIZE);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(t1 - t0).count() / kBlocks;
+    };
+
+    std::vector<float> full, eco;
+    const double fullUs = run(VoiceBank::Quality::Full, full);
+    const double ecoUs = run(VoiceBank::Quality::Eco, eco);
+    std::cout << "[METRIC] voicebank_group_block_us_full=" << fullUs << std::endl;
+    std::cout << "[METRIC] voicebank_group_block_us_eco=" << ecoUs << std::endl;
+
+    double diff = 0.0, energy = 0.0;
+    for (std::size_t i = 0; i < full.size(); ++i) {
+        diff += (full[i] - eco[i]) * (full[i] - eco[i]);
+        energy += full[i] * full[i];
+    }
+    ASSERT_GT(energy, 0.0);
+    EXPECT_LT(std::sqrt(diff / energy), 0.1) << "eco should sound like the full filter";
+}
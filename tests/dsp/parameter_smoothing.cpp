@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "JunoVoice.hpp"
+#include "ParameterSmoother.hpp"
+#include "VoiceBank.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+// Advances `s` until it settles; returns the number of sub-blocks taken and
+// whether any step overshot the target or moved away from it.
+template <int Lanes>
+int runToTarget(SmoothedLanes<Lanes> &s, const SmoothingSpec &spec, bool &monotonic) {
+    monotonic = true;
+    int subBlocks = 0;
+    while (s.value[0] != s.target[0] && subBlocks < 100000) {
+        const float before = std::fabs(s.target[0] - s.value[0]);
+        const float sign = std::copysign(1.0f, s.target[0] - s.value[0]);
+        s.advance(spec);
+        const float after = s.target[0] - s.value[0];
+        monotonic = monotonic && std::fabs(after) < before && after * sign >= 0.0f;
+        ++subBlocks;
+    }
+    return subBlocks;
+}
+
+} // namespace
+
+TEST(Smoothing, LinearRampLandsOnTargetInRampTime) {
+    SmoothingSpec spec{SmoothingSpec::Shape::Linear, 0.02f};
+    spec.configure(TEST_SAMPLE_RATE);
+
+    SmoothedLanes<4> s;
+    s.fill(0.2f);
+    s.setTargetAll(0.9f, spec);
+
+    bool monotonic = false;
+    const int subBlocks = runToTarget(s, spec, monotonic);
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(s.value[0], 0.9f);
+    EXPECT_EQ(s.value[3], 0.9f);
+    EXPECT_NEAR(subBlocks * kSmoothingFrames, 0.02f * TEST_SAMPLE_RATE, kSmoothingFrames);
+    EXPECT_FALSE(s.advance(spec));
+}
+
+TEST(Smoothing, ExponentialRampSettlesWithoutOvershoot) {
+    SmoothingSpec spec{SmoothingSpec::Shape::Exponential, 0.02f};
+    spec.configure(TEST_SAMPLE_RATE);
+
+    for (float target : {8000.0f, 120.0f}) {
+        SmoothedLanes<1> s;
+        s.fill(1000.0f);
+        s.setTarget(0, target, spec);
+
+        bool monotonic = false;
+        const int subBlocks = runToTarget(s, spec, monotonic);
+        EXPECT_TRUE(monotonic);
+        EXPECT_EQ(s.value[0], target);
+        // Settles within a few ramp times rather than creeping forever.
+        EXPECT_LT(subBlocks * kSmoothingFrames, 4.0f * 0.02f * TEST_SAMPLE_RATE);
+    }
+}
+
+TEST(Smoothing, CutoffJumpDoesNotStepTheOutput) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+
+    JunoVoice voice;
+    voice.initialize(sampleRate);
+    voice.setParam("cutoff", 200.0f);
+    voice.setParam("release", 1.0f);
+    voice.noteOn(45, 1.0f);
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    for (int b = 0; b < 32; ++b) voice.renderBlock(left.data(), right.data(), bufferSize);
+    float last = left[bufferSize - 1];
+
+    // A 200 Hz -> 12 kHz jump, unsmoothed, lets the saw edge through in one
+    // sample; smoothed, consecutive samples stay close to the settled case.
+    voice.setParam("cutoff", 12000.0f);
+    float maxJump = 0.0f;
+    for (int b = 0; b < 4; ++b) {
+        voice.renderBlock(left.data(), right.data(), bufferSize);
+        for (int i = 0; i < 8 && b == 0; ++i) {
+            maxJump = std::max(maxJump, std::fabs(left[i] - last));
+            last = left[i];
+        }
+    }
+    EXPECT_LT(maxJump, 0.05f);
+}
+
+// The sub-block clock runs across calls, so how the host splits its blocks
+// must not change what a ramp sounds like.
+TEST(Smoothing, SplitRenderMatchesOneBlock) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int frames = 128;
+    const int pieces[] = {1, 7, 13, 29, 78};
+
+    auto voiceRender = [&](bool split) {
+        JunoVoice voice;
+        voice.initialize(sampleRate);
+        voice.noteOn(45, 1.0f);
+        std::vector<float> left(frames), right(frames);
+        voice.renderBlock(left.data(), right.data(), 37);   // off the sub-block grid
+        voice.setParam("cutoff", 6000.0f);
+        voice.setParam("pwmDepth", 0.2f);
+        voice.setParam("subLevel", 0.7f);
+        if (!split) {
+            voice.renderBlock(left.data(), right.data(), frames);
+        } else {
+            int at = 0;
+            for (int p : pieces) {
+                voice.renderBlock(left.data() + at, right.data() + at, p);
+                at += p;
+            }
+        }
+        return left;
+    };
+
+    auto bankRender = [&](bool split) {
+        VoiceBank bank;
+        bank.initialize(sampleRate, VoiceBank::kLanes, frames);
+        bank.noteOn(0, 45, 1.0f);
+        bank.noteOn(1, 57, 0.8f);
+        const std::size_t stride = frames;
+        std::vector<float> out(stride * VoiceBank::kLanes), scratch(out.size());
+        bank.renderGroup(0, scratch.data(), nullptr, stride, 37);
+        bank.setParam(ParamId::Cutoff, 6000.0f);
+        bank.setParam(ParamId::PwmDepth, 0.2f);
+        bank.setParam(ParamId::SubLevel, 0.7f);
+        if (!split) {
+            bank.renderGroup(0, out.data(), nullptr, stride, frames);
+        } else {
+            int at = 0;
+            for (int p : pieces) {
+                bank.renderGroup(0, scratch.data(), nullptr, stride, p);
+                for (int l = 0; l < VoiceBank::kLanes; ++l) {
+                    std::copy_n(scratch.data() + l * stride, p, out.data() + l * stride + at);
+                }
+                at += p;
+            }
+        }
+        return out;
+    };
+
+    const std::vector<float> voiceWhole = voiceRender(false);
+    const std::vector<float> voiceSplit = voiceRender(true);
+    for (int i = 0; i < frames; ++i) ASSERT_EQ(voiceWhole[i], voiceSplit[i]) << "JunoVoice frame " << i;
+
+    const std::vector<float> bankWhole = bankRender(false);
+    const std::vector<float> bankSplit = bankRender(true);
+    for (int l = 0; l < 2; ++l) {
+        for (int i = 0; i < frames; ++i) {
+            ASSERT_EQ(bankWhole[l * frames + i], bankSplit[l * frames + i])
+                << "VoiceBank lane " << l << " frame " << i;
+        }
+    }
+}
+
+TEST(Smoothing, AutomationRenderCost) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+    constexpr int blocks = 400;
+
+    JunoDSPEngine engine;
+    engine.initialize(sampleRate, bufferSize, polyphony, false);
+    for (int v = 0; v < polyphony; ++v) engine.noteOn(48 + v, 0.7f);
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    auto run = [&](bool automate) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < blocks; ++b) {
+            if (automate) {
+                // A new cutoff and resonance every block, as from a fast knob.
+                engine.setParameter(ParamId::Cutoff, 300.0f + 40.0f * static_cast<float>(b % 100));
+                engine.setParameter(ParamId::Resonance, 0.2f + 0.005f * static_cast<float>(b % 100));
+            }
+            engine.renderAudio(left.data(), right.data(), bufferSize);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / blocks;
+    };
+
+    // Best of a few runs each, interleaved, so a busy machine cannot make
+    // one side look slow.
+    run(false);
+    double settledUs = 1e30, automatedUs = 1e30;
+    for (int r = 0; r < 3; ++r) {
+        settledUs = std::min(settledUs, run(false));
+        automatedUs = std::min(automatedUs, run(true));
+    }
+
+    std::cout << "[METRIC] Block render settled (us): " << settledUs
+              << " | under automation (us): " << automatedUs << std::endl;
+
+    // Ramps cost one coefficient update per sub-block, not per sample, so
+    // automating every block stays within a small factor of settled.
+    EXPECT_LT(automatedUs, 2.0 * settledUs);
+}
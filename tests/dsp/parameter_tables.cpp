@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "ParameterScaler.hpp"
+#include "PatchCurves.hpp"
+#include "VoiceBank.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+using Juno106::ParameterScaler;
+
+// Generated by the compiler, not at startup.
+static_assert(ParameterScaler::kNoteHz[69] == 440.0f, "A4 must be exact");
+static_assert(ParameterScaler::kCutoffHz[0] == 50.0f, "curve starts at lo");
+
+namespace {
+
+// Largest relative difference between `table` and lo * (hi / lo)^(i / 127).
+double worstCurveError(const Juno106::CurveTable &table, double lo, double hi) {
+    double worst = 0.0;
+    for (int i = 0; i < 128; ++i) {
+        const double ref = lo * std::pow(hi / lo, i / 127.0);
+        worst = std::max(worst, std::fabs(table[static_cast<std::size_t>(i)] / ref - 1.0));
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST(ParameterTables, CurvesMatchTheLibmFormulas) {
+    EXPECT_LT(worstCurveError(ParameterScaler::kCutoffHz, 50.0, 15000.0), 1e-7);
+    EXPECT_LT(worstCurveError(ParameterScaler::kAttackSeconds, 0.0015, 3.0), 1e-7);
+    EXPECT_LT(worstCurveError(ParameterScaler::kDecaySeconds, 0.0015, 12.0), 1e-7);
+    EXPECT_LT(worstCurveError(ParameterScaler::kLfoHz, 0.5, 30.0), 1e-7);
+    EXPECT_LT(worstCurveError(PatchCurves::kAttackSeconds, 0.0015, 1.5), 1e-7);
+    EXPECT_LT(worstCurveError(PatchCurves::kReleaseSeconds, 0.0015, 0.0015 * std::pow(10.0, 3.6)), 1e-7);
+
+    for (int note = 0; note < 128; ++note) {
+        const double ref = 440.0 * std::pow(2.0, (note - 69) / 12.0);
+        EXPECT_NEAR(ParameterScaler::noteToHz(note) / ref, 1.0, 1e-7) << "note " << note;
+    }
+    EXPECT_EQ(ParameterScaler::noteToHz(-5), ParameterScaler::noteToHz(0));
+    EXPECT_EQ(ParameterScaler::noteToHz(200), ParameterScaler::noteToHz(127));
+    EXPECT_EQ(ParameterScaler::vcfCutoffToHz(255), ParameterScaler::vcfCutoffToHz(127));
+}
+
+TEST(ParameterTables, EnvelopeStepsLookUpWhatTheyWouldCompute) {
+    EnvelopeSteps steps;
+    steps.build(TEST_SAMPLE_RATE);
+    for (std::size_t i = 0; i < 128; ++i) {
+        for (float seconds : {PatchCurves::kAttackSeconds[i], PatchCurves::kReleaseSeconds[i]}) {
+            EXPECT_EQ(steps.step(seconds), PatchCurves::envelopeStep(seconds, TEST_SAMPLE_RATE));
+        }
+    }
+    // Off-curve times are computed.
+    EXPECT_EQ(steps.step(0.123f), PatchCurves::envelopeStep(0.123f, TEST_SAMPLE_RATE));
+    EXPECT_EQ(steps.step(0.0f), 1.0f);
+}
+
+TEST(ParameterTables, NoteOnCost) {
+    constexpr int kNotes = 20000;
+    VoiceBank bank;
+    bank.initialize(TEST_SAMPLE_RATE, TEST_POLYPHONY, TEST_BUFFER_SIZE);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < kNotes; ++n) {
+        bank.noteOn(n % TEST_POLYPHONY, 36 + n % 61, 0.8f);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    EXPECT_GT(bank.frequency(0), 0.0f);
+
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / kNotes;
+    std::cout << "[METRIC] note_on_ns=" << ns << std::endl;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// The workload cpu_bench.cpp (JunoDSPEngine, juno_tests) and
+// analog_cpu_bench.cpp (JunoEngine, juno_analog_tests) both time, so their
+// [METRIC] realtime_factor lines compare the engines directly. The engines
+// cannot share a binary (their JunoVoice classes clash), hence the header.
+namespace realtime_factor {
+
+// JunoEngine::VOICE_COUNT; both engines hold this many notes.
+constexpr int kVoices = 6;
+constexpr int kWarmupBlocks = 20;
+constexpr int kBlocks = 400;
+
+// A spread chord, one note per voice.
+inline int note(int voice) { return 48 + 5 * voice; }
+
+struct Result {
+    double meanUs = 0.0;
+    double p99Us = 0.0;
+    double realtimeFactor = 0.0;   // audio time rendered per unit of wall time
+};
+
+// Times `render(left, right, frames)` over kBlocks after kWarmupBlocks.
+template <typename Render>
+Result measure(Render &&render, int sampleRate, int frames) {
+    std::vector<float> left(static_cast<std::size_t>(frames));
+    std::vector<float> right(left.size());
+    for (int b = 0; b < kWarmupBlocks; ++b) render(left.data(), right.data(), frames);
+
+    std::vector<double> us;
+    us.reserve(kBlocks);
+    for (int b = 0; b < kBlocks; ++b) {
+        const auto start = std::chrono::steady_clock::now();
+        render(left.data(), right.data(), frames);
+        const auto end = std::chrono::steady_clock::now();
+        us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    Result r;
+    r.meanUs = std::accumulate(us.begin(), us.end(), 0.0) / static_cast<double>(us.size());
+    const auto p99 = us.begin() + static_cast<std::ptrdiff_t>(us.size() * 99 / 100);
+    std::nth_element(us.begin(), p99, us.end());
+    r.p99Us = *p99;
+    r.realtimeFactor = (1e6 * frames / sampleRate) / r.meanUs;
+    return r;
+}
+
+inline void report(const char *engine, const Result &r, int sampleRate, int frames) {
+    std::cout << "[METRIC] realtime_factor engine=" << engine << " sr=" << sampleRate
+              << " frames=" << frames << " voices=" << kVoices << " factor=" << r.realtimeFactor
+              << " block_us=" << r.meanUs << " p99_us=" << r.p99Us
+              << " per_voice_us=" << r.meanUs / kVoices << std::endl;
+}
+
+} // namespace realtime_factor
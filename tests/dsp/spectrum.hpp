@@ -0,0 +1,36 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// Spectral checks shared by the aliasing tests of both engines
+// (band_limited_dco.cpp and oversampling.cpp in juno_tests, analog_dco.cpp
+// in juno_analog_tests).
+namespace spectrum {
+
+// Energy outside the harmonics of bin `k`, relative to the total, in dB.
+// With N a power of two and k odd, no aliased harmonic can fold onto a
+// harmonic bin.
+inline double aliasLevelDb(const std::vector<float> &x, int k) {
+    constexpr double kPi = 3.14159265358979323846;
+    const int n = static_cast<int>(x.size());
+    std::vector<double> cosTable(static_cast<std::size_t>(n)), sinTable(cosTable.size());
+    for (int i = 0; i < n; ++i) {
+        cosTable[static_cast<std::size_t>(i)] = std::cos(2.0 * kPi * i / n);
+        sinTable[static_cast<std::size_t>(i)] = std::sin(2.0 * kPi * i / n);
+    }
+    double harmonic = 0.0;
+    double alias = 0.0;
+    for (int bin = 1; bin < n / 2; ++bin) {
+        double re = 0.0;
+        double im = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const std::size_t idx = static_cast<std::size_t>((static_cast<long long>(bin) * i) % n);
+            re += x[static_cast<std::size_t>(i)] * cosTable[idx];
+            im -= x[static_cast<std::size_t>(i)] * sinTable[idx];
+        }
+        (bin % k == 0 ? harmonic : alias) += re * re + im * im;
+    }
+    return 10.0 * std::log10(alias / (harmonic + alias));
+}
+
+} // namespace spectrum
@@ -0,0 +1,183 @@
+#include <array>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "VoiceAllocator.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+using Policy = VoiceAllocator::Policy;
+
+TEST(VoiceAllocator, FreeVoicesAreUsedFirst) {
+    VoiceAllocator alloc;
+    alloc.initialize(4);
+    for (int n = 0; n < 4; ++n) {
+        EXPECT_EQ(alloc.noteOn(60 + n), n);
+    }
+    EXPECT_EQ(alloc.freeCount(), 0);
+    EXPECT_EQ(alloc.heldCount(), 4);
+}
+
+TEST(VoiceAllocator, OldestStealsLongestReleasedThenOldestHeld) {
+    VoiceAllocator alloc;
+    alloc.initialize(3);
+    alloc.noteOn(60);
+    alloc.noteOn(62);
+    alloc.noteOn(64);
+
+    // Released voices go before held ones, in note-off order.
+    EXPECT_EQ(alloc.noteOff(64), 2);
+    EXPECT_EQ(alloc.noteOff(60), 0);
+    EXPECT_EQ(alloc.noteOn(65), 2);
+    EXPECT_EQ(alloc.noteOn(67), 0);
+
+    // Everything held: the earliest note-on goes.
+    EXPECT_EQ(alloc.noteOn(69), 1);
+    EXPECT_EQ(alloc.note(1), 69);
+}
+
+TEST(VoiceAllocator, QuietestStealsTheLowestLevel) {
+    VoiceAllocator alloc;
+    alloc.initialize(4);
+    alloc.setPolicy(Policy::Quietest);
+    for (int n = 0; n < 4; ++n) alloc.noteOn(60 + n);
+
+    const std::array<float, 4> levels{0.8f, 0.3f, 0.1f, 0.5f};
+    auto level = [&](int v) { return levels[static_cast<std::size_t>(v)]; };
+    EXPECT_EQ(alloc.noteOn(70, level), 2);
+
+    // A released voice is preferred even when a held one is quieter.
+    alloc.noteOff(60);
+    EXPECT_EQ(alloc.noteOn(71, level), 0);
+}
+
+TEST(VoiceAllocator, RoundRobinRotatesThroughEveryVoice) {
+    VoiceAllocator alloc;
+    alloc.initialize(3);
+    alloc.setPolicy(Policy::RoundRobin);
+    std::vector<int> order;
+    for (int n = 0; n < 7; ++n) {
+        order.push_back(alloc.noteOn(60 + n));
+        alloc.noteOff(60 + n);
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 0, 1, 2, 0}));
+}
+
+TEST(VoiceAllocator, DuplicateNotesNeedOneReleaseEach) {
+    VoiceAllocator alloc;
+    alloc.initialize(4);
+    const int first = alloc.noteOn(60);
+    const int second = alloc.noteOn(60);
+    EXPECT_NE(first, second);
+
+    EXPECT_EQ(alloc.noteOff(60), first);
+    EXPECT_TRUE(alloc.isHeld(second));
+    EXPECT_EQ(alloc.noteOff(60), second);
+    EXPECT_EQ(alloc.noteOff(60), -1);
+}
+
+TEST(VoiceAllocator, SameNoteRetriggerCountsPresses) {
+    VoiceAllocator alloc;
+    alloc.initialize(4);
+    alloc.setPolicy(Policy::SameNoteRetrigger);
+    const int v = alloc.noteOn(60);
+    EXPECT_EQ(alloc.noteOn(60), v);
+    EXPECT_EQ(alloc.heldCount(), 1);
+
+    EXPECT_EQ(alloc.noteOff(60), -1);
+    EXPECT_TRUE(alloc.isHeld(v));
+    EXPECT_EQ(alloc.noteOff(60), v);
+
+    // A released voice is picked up again by the next press of its note.
+    EXPECT_EQ(alloc.noteOn(60), v);
+    EXPECT_EQ(alloc.noteOff(60), v);
+}
+
+TEST(VoiceAllocator, StolenVoiceIgnoresTheOldNoteOff) {
+    VoiceAllocator alloc;
+    alloc.initialize(2);
+    alloc.noteOn(60);
+    alloc.noteOn(62);
+    EXPECT_EQ(alloc.noteOn(64), 0);
+    EXPECT_EQ(alloc.noteOff(60), -1);
+    EXPECT_TRUE(alloc.isHeld(0));
+    EXPECT_EQ(alloc.noteOff(64), 0);
+}
+
+TEST(VoiceAllocator, ReclaimFreesOnlySilentReleasedVoices) {
+    VoiceAllocator alloc;
+    alloc.initialize(3);
+    alloc.noteOn(60);
+    alloc.noteOn(62);
+    alloc.noteOn(64);
+    alloc.noteOff(60);
+    alloc.noteOff(62);
+
+    alloc.reclaim([](int v) { return v == 1; });
+    EXPECT_TRUE(alloc.isFree(0));
+    EXPECT_FALSE(alloc.isFree(1));
+    EXPECT_TRUE(alloc.isHeld(2));
+    EXPECT_EQ(alloc.note(0), -1);
+
+    // The freed voice is handed out before the one still ringing.
+    EXPECT_EQ(alloc.noteOn(65), 0);
+}
+
+TEST(VoiceAllocator, EngineHoldsDuplicateNoteUntilBothReleased) {
+    JunoDSPEngine engine;
+    ASSERT_TRUE(engine.initialize(TEST_SAMPLE_RATE, TEST_BUFFER_SIZE, TEST_POLYPHONY, false));
+    engine.start();
+
+    std::vector<float> left(TEST_BUFFER_SIZE), right(TEST_BUFFER_SIZE);
+    auto renderFor = [&](double seconds) {
+        bool silent = false;
+        const int blocks = static_cast<int>(seconds * TEST_SAMPLE_RATE / TEST_BUFFER_SIZE);
+        for (int b = 0; b < blocks; ++b) {
+            silent = engine.renderAudio(left.data(), right.data(), TEST_BUFFER_SIZE);
+        }
+        return silent;
+    };
+
+    engine.noteOn(60, 0.8f);
+    engine.noteOn(60, 0.8f);
+    renderFor(0.1);
+    engine.noteOff(60);
+    EXPECT_FALSE(renderFor(10.0)) << "second press was released by the first note-off";
+
+    engine.noteOff(60);
+    EXPECT_TRUE(renderFor(20.0));
+    engine.stop();
+}
+
+TEST(VoiceAllocator, AllocationCost) {
+    constexpr int kVoices = 64;
+    constexpr int kEvents = 200000;
+    VoiceAllocator alloc;
+    alloc.initialize(kVoices);
+
+    int sink = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kEvents; ++i) {
+        const int note = 24 + (i * 7) % 80;
+        sink += alloc.noteOn(note);
+        sink += alloc.noteOff(24 + (i * 5) % 80);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / kEvents;
+    std::cout << "[METRIC] voice_allocator_ns_per_note_pair_" << kVoices << "=" << ns
+              << " (sink " << sink << ")" << std::endl;
+    EXPECT_GT(ns, 0.0);
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+namespace {
+
+// CPU time and context switches of the calling thread. A voluntary switch
+// means the thread blocked (e.g. on a lock); an involuntary one means the OS
+// preempted it.
+struct ThreadUsage {
+    double cpuMs = 0.0;
+    long voluntary = 0;
+    long involuntary = 0;
+};
+
+ThreadUsage threadUsage() {
+    ThreadUsage u;
+#if defined(__linux__)
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        u.cpuMs = ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        u.voluntary = usage.ru_nvcsw;
+        u.involuntary = usage.ru_nivcsw;
+    }
+#endif
+    return u;
+}
+
+} // namespace
+
+// Published parameters reach the render thread whole, at block start.
+TEST(AnalogEngine, SnapshotPublishesWholeUpdates) {
+    TripleBuffer<JunoEngine::Snapshot> buffer;
+    EXPECT_FALSE(buffer.acquire());
+
+    buffer.update([](JunoEngine::Snapshot &s) {
+        s.voice.cutoffHz = 2500.0f;
+        s.chorusMode = 2;
+    });
+    buffer.update([](JunoEngine::Snapshot &s) { s.cableLength = 7.0f; });
+
+    ASSERT_TRUE(buffer.acquire());
+    EXPECT_FLOAT_EQ(buffer.read().voice.cutoffHz, 2500.0f);
+    EXPECT_EQ(buffer.read().chorusMode, 2);
+    EXPECT_FLOAT_EQ(buffer.read().cableLength, 7.0f);
+    EXPECT_FALSE(buffer.acquire());
+}
+
+// Several control threads hammer the setters while the audio thread renders
+// at the device rate. With the old render mutex a preempted setter could
+// stall the callback; now the callback must never block, and no callback may
+// need more time than its buffer lasts. The test thread is not real-time, so
+// the deadline is checked against the callback's own CPU time, and callbacks
+// the OS preempted (which a loaded single-core CI box does often, inflating
+// both clocks) are counted but not held to it.
+TEST(AnalogEngine, ParameterHammeringNeverBlocksRender) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int callbacks = 1000;
+    const double deadlineMs = 1000.0 * bufferSize / sampleRate;
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(deadlineMs));
+
+    JunoEngine engine;
+    engine.init(sampleRate);
+    engine.setChorusMode(1);
+    for (int note : {48, 55, 60, 64, 67, 72}) {
+        engine.noteOn(note, 0.8f);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<long> updates{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 3; ++t) {
+        writers.emplace_back([&, t] {
+            int i = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                for (int burst = 0; burst < 16; ++burst, ++i) {
+                    const float x = static_cast<float>((i + t * 17) % 100) / 100.0f;
+                    engine.setAnalogCharacter(x, 1.0f - x, x, 1.0f + 5.0f * x, x, x);
+                    VoiceParams p;
+                    p.cutoffHz = 200.0f + 8000.0f * x;
+                    p.resonance = x;
+                    engine.setVoiceParams(p);
+                    engine.setChorusMode(i % 3);
+                }
+                updates.fetch_add(16 * 3, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    std::vector<double> callbackMs;
+    callbackMs.reserve(callbacks);
+    double worstCpuMs = 0.0;
+    long blockedCallbacks = 0;
+    long preemptedCallbacks = 0;
+    long overruns = 0;
+    bool finite = true;
+    auto nextCallback = std::chrono::steady_clock::now();
+    for (int c = 0; c < callbacks; ++c) {
+        std::this_thread::sleep_until(nextCallback);
+        nextCallback += period;
+        const ThreadUsage before = threadUsage();
+        const auto t0 = std::chrono::steady_clock::now();
+        engine.render(left.data(), right.data(), bufferSize);
+        const auto t1 = std::chrono::steady_clock::now();
+        const ThreadUsage after = threadUsage();
+
+        callbackMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        const double cpuMs = after.cpuMs - before.cpuMs;
+        const bool preempted = after.involuntary != before.involuntary;
+        blockedCallbacks += after.voluntary != before.voluntary ? 1 : 0;
+        preemptedCallbacks += preempted ? 1 : 0;
+        if (!preempted) {
+            worstCpuMs = std::max(worstCpuMs, cpuMs);
+            overruns += cpuMs > deadlineMs ? 1 : 0;
+        }
+        for (int i = 0; i < bufferSize; ++i) {
+            finite = finite && std::isfinite(left[i]) && std::isfinite(right[i]);
+        }
+        if (c % 64 == 0) {
+            engine.noteOn(48 + c % 24, 0.7f);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &w : writers) w.join();
+
+    std::sort(callbackMs.begin(), callbackMs.end());
+    const double median = callbackMs[callbackMs.size() / 2];
+    const double worst = callbackMs.back();
+    std::cout << "[METRIC] Analog engine under parameter load: median "
+              << median << " ms, worst " << worst << " ms wall / " << worstCpuMs
+              << " ms CPU of " << deadlineMs << " ms deadline, "
+              << updates.load() << " updates, " << preemptedCallbacks
+              << " preempted, " << blockedCallbacks << " blocked, "
+              << overruns << " overruns\n";
+
+    EXPECT_TRUE(finite);
+    EXPECT_GT(updates.load(), 0);
+    EXPECT_EQ(blockedCallbacks, 0);
+    EXPECT_EQ(overruns, 0);
+}
@@ -0,0 +1,39 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+TEST(AnalogSilence, IdleEngineSkipsTheBus) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+
+    JunoEngine engine;
+    engine.init(TEST_SAMPLE_RATE);
+    VoiceParams p;
+    p.envRelease = 0.01f;
+    engine.setVoiceParams(p);
+
+    std::vector<float> left(bufferSize, 1.0f), right(bufferSize, 1.0f);
+    EXPECT_TRUE(engine.render(left.data(), right.data(), bufferSize));
+    EXPECT_TRUE(std::all_of(left.begin(), left.end(), [](float s) { return s == 0.0f; }));
+
+    engine.noteOn(60, 1.0f);
+    EXPECT_FALSE(engine.render(left.data(), right.data(), bufferSize));
+    engine.noteOff(60);
+
+    int audibleBlocks = 0;
+    while (!engine.render(left.data(), right.data(), bufferSize)) {
+        ASSERT_LT(++audibleBlocks, 10 * TEST_SAMPLE_RATE / bufferSize);
+    }
+    // The chorus/cable tail is played out after the voice goes idle.
+    EXPECT_GE(audibleBlocks * bufferSize, TEST_SAMPLE_RATE / 25);
+    EXPECT_TRUE(std::all_of(right.begin(), right.end(), [](float s) { return s == 0.0f; }));
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "EventQueue.hpp"
+#include "JunoDSPEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+// Several producers push tagged events while one consumer drains; every
+// event must arrive exactly once and in order per producer.
+TEST(EventQueue, MultipleProducersLoseNothing) {
+    constexpr int producers = 4;
+    constexpr int perProducer = 20000;
+
+    EventQueue queue;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < perProducer; ++i) {
+                EngineEvent e;
+                e.note = p;
+                e.time = i;
+                while (!queue.push(e)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::int64_t> next(producers, 0);
+    int received = 0;
+    bool ordered = true;
+    go.store(true, std::memory_order_release);
+    while (received < producers * perProducer) {
+        EngineEvent e;
+        if (!queue.pop(e)) continue;
+        ASSERT_GE(e.note, 0);
+        ASSERT_LT(e.note, producers);
+        ordered = ordered && e.time == next[static_cast<std::size_t>(e.note)];
+        next[static_cast<std::size_t>(e.note)] = e.time + 1;
+        ++received;
+    }
+    for (auto &t : threads) t.join();
+
+    EXPECT_TRUE(ordered);
+    EngineEvent extra;
+    EXPECT_FALSE(queue.pop(extra));
+    for (int p = 0; p < producers; ++p) {
+        EXPECT_EQ(next[static_cast<std::size_t>(p)], perProducer);
+    }
+}
+
+TEST(EventQueue, RejectsPushWhenFull) {
+    EventQueue queue;
+    EngineEvent e;
+    for (std::size_t i = 0; i < EventQueue::kCapacity; ++i) {
+        ASSERT_TRUE(queue.push(e));
+    }
+    EXPECT_FALSE(queue.push(e));
+    ASSERT_TRUE(queue.pop(e));
+    EXPECT_TRUE(queue.push(e));
+}
+
+// Notes and parameters from several control threads while the audio thread
+// renders; the engine must keep producing finite output.
+TEST(EventQueue, ConcurrentControlThreadsWhileRendering) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    JunoDSPEngine engine;
+    ASSERT_TRUE(engine.initialize(sampleRate, bufferSize, polyphony, false));
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> controls;
+    for (int t = 0; t < 3; ++t) {
+        controls.emplace_back([&, t] {
+            int i = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const int note = 48 + (i + t * 5) % 24;
+                engine.noteOn(note, 0.7f);
+                engine.setParameter(ParamId::Cutoff, 300.0f + 50.0f * (i % 100));
+                engine.setParameter("resonance", 0.1f * (i % 10));
+                engine.noteOff(note);
+                ++i;
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    bool finite = true;
+    for (int block = 0; block < 400; ++block) {
+        engine.renderAudio(left.data(), right.data(), bufferSize);
+        for (int i = 0; i < bufferSize; ++i) {
+            finite = finite && std::isfinite(left[i]) && std::isfinite(right[i]);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : controls) t.join();
+
+    EXPECT_TRUE(finite);
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+// Index of the first frame with audible output, or -1.
+int firstSoundingFrame(const std::vector<float> &buffer) {
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        if (buffer[i] != 0.0f) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(MIDI, NoteOnIsSampleAccurate) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    JunoDSPEngine engine;
+    engine.initialize(sampleRate, bufferSize, polyphony, false);
+    engine.setParameter("chorusMode", 0.0f);
+    engine.setParameter("release", 0.005f);
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    int maxJitter = 0;
+    for (int trial = 0; trial < 16; ++trial) {
+        // Offsets cover the start, middle and end of the upcoming buffer.
+        const int offset = (trial * 37) % bufferSize;
+        const std::int64_t start = engine.currentSampleTime();
+        engine.noteOnAt(60, 0.8f, start + offset);
+        engine.noteOffAt(60, start + bufferSize);
+
+        engine.renderAudio(left.data(), right.data(), bufferSize);
+        const int first = firstSoundingFrame(left);
+        ASSERT_GE(first, 0);
+        maxJitter = std::max(maxJitter, std::abs(first - offset));
+
+        // Let the release finish before the next trial.
+        for (int i = 0; i < sampleRate / bufferSize; ++i) {
+            engine.renderAudio(left.data(), right.data(), bufferSize);
+        }
+    }
+
+    std::cout << "[METRIC] Note-on timing jitter (frames): " << maxJitter << std::endl;
+    EXPECT_EQ(maxJitter, 0);
+}
+
+TEST(MIDI, HostTimeStampedNoteOn) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    JunoDSPEngine engine;
+    engine.initialize(sampleRate, bufferSize, polyphony, false);
+    engine.setParameter("chorusMode", 0.0f);
+
+    const std::uint64_t blockHostTime = 5'000'000'000ull;
+    const int offset = bufferSize / 2;
+    EngineEvent e;
+    e.type  = EngineEvent::Type::NoteOn;
+    e.base  = EngineEvent::TimeBase::HostNanos;
+    e.note  = 64;
+    e.value = 1.0f;
+    e.time  = static_cast<std::int64_t>(blockHostTime) +
+              static_cast<std::int64_t>(std::llround(offset * 1e9 / sampleRate));
+    ASSERT_TRUE(engine.scheduleEvent(e));
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    engine.renderAudio(left.data(), right.data(), bufferSize, blockHostTime);
+    EXPECT_EQ(firstSoundingFrame(left), offset);
+}
+
+// With the pending list full, a future event must not sound early; a due
+// one is still applied on time.
+TEST(MIDI, FullPendingListDropsFutureEventsOnly) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    JunoDSPEngine engine;
+    engine.initialize(sampleRate, bufferSize, polyphony, false);
+    engine.setParameter("chorusMode", 0.0f);
+
+    // Fill the pending list with parameter changes far in the future.
+    std::vector<float> left(bufferSize), right(bufferSize);
+    const std::int64_t later = engine.currentSampleTime() + 100 * sampleRate;
+    for (int i = 0; i < 1024; ++i) {
+        engine.setParameterAt(ParamId::Resonance, 0.1f, later);
+    }
+    engine.renderAudio(left.data(), right.data(), bufferSize);
+    ASSERT_EQ(engine.droppedEvents(), 0u);
+
+    engine.noteOnAt(60, 0.8f, engine.currentSampleTime() + bufferSize / 2);
+    engine.renderAudio(left.data(), right.data(), bufferSize);
+    EXPECT_EQ(firstSoundingFrame(left), -1);
+    EXPECT_EQ(engine.droppedEvents(), 1u);
+
+    engine.noteOnAt(60, 0.8f, engine.currentSampleTime());
+    engine.renderAudio(left.data(), right.data(), bufferSize);
+    EXPECT_EQ(firstSoundingFrame(left), 0);
+    EXPECT_EQ(engine.droppedEvents(), 1u);
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "OfflineRenderer.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 4
+#endif
+
+TEST(OfflineRender, ParsesMidiWithTempoChange) {
+    // Format 0, 96 PPQ: note on at tick 0, tempo -> 1 s per quarter at
+    // tick 96, note off at tick 192.
+    const std::vector<std::uint8_t> smf = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96,
+        'M', 'T', 'r', 'k', 0, 0, 0, 19,
+        0x00, 0x90, 60, 127,
+        0x60, 0xFF, 0x51, 0x03, 0x0F, 0x42, 0x40,
+        0x60, 0x80, 60, 0,
+        0x00, 0xFF, 0x2F, 0x00,
+    };
+
+    const auto events = OfflineRenderer::parseMidi(smf);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type, OfflineEvent::Type::NoteOn);
+    EXPECT_EQ(events[0].note, 60);
+    EXPECT_FLOAT_EQ(events[0].value, 1.0f);
+    EXPECT_DOUBLE_EQ(events[0].time, 0.0);
+    EXPECT_EQ(events[1].type, OfflineEvent::Type::NoteOff);
+    EXPECT_NEAR(events[1].time, 0.5 + 1.0, 1e-9);
+}
+
+TEST(OfflineRender, RendersEventListSampleAccurately) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    const auto events = OfflineRenderer::parseEventList(
+        "# time kind args\n"
+        "0.0 param chorusMode 0\n"
+        "0.1 on 60 0.8\n"
+        "0.3 off 60\n");
+    ASSERT_EQ(events.size(), 3u);
+
+    JunoDSPEngine engine;
+    engine.initialize(sampleRate, bufferSize, polyphony, false);
+    const auto result = OfflineRenderer::render(engine, events, sampleRate, bufferSize, 0.5);
+
+    const std::size_t noteFrame = static_cast<std::size_t>(std::llround(0.1 * sampleRate));
+    ASSERT_EQ(result.left.size(), static_cast<std::size_t>(std::ceil(0.8 * sampleRate)));
+    for (std::size_t i = 0; i < noteFrame; ++i) {
+        ASSERT_EQ(result.left[i], 0.0f) << "audio before the note at frame " << i;
+    }
+    const float peak = *std::max_element(result.left.begin() + noteFrame,
+                                         result.left.begin() + noteFrame + sampleRate / 10);
+    EXPECT_GT(peak, 0.0f);
+    EXPECT_GT(result.realtimeFactor(), 0.0);
+}
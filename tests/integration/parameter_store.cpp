@@ -0,0 +1,154 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "RCUParameterManager.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 48000
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 256
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+TEST(ParameterStore, BurstOfUpdatesIsNeverDropped) {
+    RCUParameterManager store;
+    const std::uint64_t before = store.version();
+    for (int i = 0; i < 1000; ++i) {
+        store.set("p" + std::to_string(i), static_cast<float>(i));
+    }
+    EXPECT_EQ(store.version(), before + 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(store.get("p" + std::to_string(i), -1.0f), static_cast<float>(i));
+    }
+    EXPECT_EQ(store.snapshot().size(), 1000u);
+
+    store.clear();
+    EXPECT_EQ(store.get("p0", -1.0f), -1.0f);
+}
+
+// Engine parameters read by id and by name agree, however they were set.
+TEST(ParameterStore, IdAndNameViewsAgree) {
+    RCUParameterManager store;
+    EXPECT_EQ(store.get(ParamId::Cutoff, -1.0f), -1.0f);
+
+    store.set(ParamId::Cutoff, 1200.0f);
+    store.set("resonance", 0.4f);
+    EXPECT_EQ(store.get("cutoff", -1.0f), 1200.0f);
+    EXPECT_EQ(store.get(ParamId::Resonance, -1.0f), 0.4f);
+    EXPECT_EQ(store.get(ParamId::Attack, -1.0f), -1.0f);
+    EXPECT_EQ(store.snapshot().size(), 2u);
+
+    store.clear();
+    EXPECT_EQ(store.get(ParamId::Cutoff, -1.0f), -1.0f);
+}
+
+// Readers on several threads while a writer publishes: every read sees a
+// fully published block, and values only move forward.
+TEST(ParameterStore, ConcurrentReadersSeeConsistentValues) {
+    RCUParameterManager store;
+    store.set("a", 0.0f);
+    store.set("b", 0.0f);
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            float lastA = 0.0f;
+            while (!done.load(std::memory_order_acquire)) {
+                const float a = store.get("a", -1.0f);
+                if (a < lastA || a < 0.0f) {
+                    consistent.store(false);
+                }
+                lastA = a;
+            }
+        });
+    }
+
+    for (int i = 1; i <= 20000; ++i) {
+        store.set("a", static_cast<float>(i));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &r : readers) r.join();
+
+    EXPECT_TRUE(consistent.load());
+    EXPECT_EQ(store.get("a"), 20000.0f);
+}
+
+// Thousands of parameter changes between two callbacks (far more than the
+// event queue holds) must land on the last value of each parameter.
+TEST(ParameterStore, EngineKeepsLastValueOfLargeBurst) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    JunoDSPEngine burst, single;
+    burst.initialize(sampleRate, bufferSize, polyphony, false);
+    single.initialize(sampleRate, bufferSize, polyphony, false);
+
+    for (int i = 0; i < 5000; ++i) {
+        burst.setParameter(ParamId::Cutoff, 200.0f + static_cast<float>(i));
+        burst.setParameter("resonance", static_cast<float>(i % 10) * 0.1f);
+    }
+    single.setParameter(ParamId::Cutoff, 200.0f + 4999.0f);
+    single.setParameter("resonance", 9.0f * 0.1f);
+    EXPECT_EQ(burst.getParameter("cutoff"), 5199.0f);
+
+    burst.noteOn(60, 0.8f);
+    single.noteOn(60, 0.8f);
+
+    std::vector<float> l1(bufferSize), r1(bufferSize), l2(bufferSize), r2(bufferSize);
+    for (int block = 0; block < 20; ++block) {
+        burst.renderAudio(l1.data(), r1.data(), bufferSize);
+        single.renderAudio(l2.data(), r2.data(), bufferSize);
+        for (int i = 0; i < bufferSize; ++i) {
+            ASSERT_EQ(l1[i], l2[i]) << "block " << block << " frame " << i;
+            ASSERT_EQ(r1[i], r2[i]) << "block " << block << " frame " << i;
+        }
+    }
+}
+
+// A timestamped change does not go through the store, so a later immediate
+// change to another parameter must not re-apply the stale stored value.
+TEST(ParameterStore, ImmediateSetKeepsEarlierTimestampedChange) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+
+    auto energyAfter = [&](bool timestamped) {
+        JunoDSPEngine engine;
+        engine.initialize(sampleRate, bufferSize, polyphony, false);
+        engine.setParameter(ParamId::Cutoff, 300.0f);
+        engine.noteOn(48, 0.8f);
+        std::vector<float> l(bufferSize), r(bufferSize);
+        engine.renderAudio(l.data(), r.data(), bufferSize);
+
+        if (timestamped) {
+            engine.setParameterAt(ParamId::Cutoff, 8000.0f, engine.currentSampleTime());
+        } else {
+            engine.setParameter(ParamId::Cutoff, 8000.0f);
+        }
+        engine.renderAudio(l.data(), r.data(), bufferSize);
+        engine.setParameter(ParamId::Resonance, 0.1f);
+
+        double energy = 0.0;
+        for (int block = 0; block < 20; ++block) {
+            engine.renderAudio(l.data(), r.data(), bufferSize);
+            for (int i = 0; i < bufferSize; ++i) energy += l[i] * l[i] + r[i] * r[i];
+        }
+        return energy;
+    };
+
+    const double timestamped = energyAfter(true);
+    const double immediate = energyAfter(false);
+    EXPECT_NEAR(timestamped, immediate, immediate * 1e-3);
+}
@@ -1,8 +1,16 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <ctime>
 #include <gtest/gtest.h>
+#include <thread>
 #include <vector>
 
 #include "JunoDSPEngine.hpp"
+#include "JunoVoice.hpp"
+#include "RenderThreadPool.hpp"
+#include "VoiceBank.hpp"
 
 #ifndef TEST_SAMPLE_RATE
 #define TEST_SAMPLE_RATE 44100
@@ -58,3 +66,225 @@ TEST(Render, DeterministicOutput) {
     EXPECT_LT(meanLeftDiff, 1e-6);
     EXPECT_LT(meanRightDiff, 1e-6);
 }
+
+TEST(Render, BlockRenderMatchesPerSampleVoice) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int blocks = 64;
+
+    JunoVoice perSample;
+    JunoVoice block;
+    perSample.initialize(sampleRate);
+    block.initialize(sampleRate);
+    for (JunoVoice *v : {&perSample, &block}) {
+        v->setParam("cutoff", 2500.0f);
+        v->setParam("resonance", 0.6f);
+        v->setParam("release", 0.01f);
+        v->setParam("subLevel", 0.5f);
+        v->noteOn(57, 0.8f);
+    }
+
+    std::vector<float> left(bufferSize, 0.0f);
+    std::vector<float> right(bufferSize, 0.0f);
+
+    double maxDiff = 0.0;
+    double energy = 0.0;
+    for (int b = 0; b < blocks; ++b) {
+        if (b == blocks / 2) {
+            perSample.noteOff(57);
+            block.noteOff(57);
+        }
+        block.renderBlock(left.data(), right.data(), bufferSize);
+        for (int i = 0; i < bufferSize; ++i) {
+            float l = 0.0f;
+            float r = 0.0f;
+            perSample.process(l, r);
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(l - left[i])));
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(r - right[i])));
+            energy += static_cast<double>(left[i]) * left[i];
+        }
+    }
+
+    EXPECT_GT(energy, 0.0);
+    EXPECT_EQ(maxDiff, 0.0);
+    EXPECT_FALSE(block.isActive());
+}
+
+TEST(Render, VoiceBankMatchesScalarVoice) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int numVoices = VoiceBank::kLanes + 2; // spans two lane groups
+    constexpr int blocks = 48;
+
+    VoiceBank bank;
+    bank.initialize(sampleRate, numVoices, bufferSize, true);
+    std::vector<JunoVoice> reference(numVoices);
+
+    const std::pair<const char *, float> params[] = {
+        {"cutoff", 1800.0f}, {"resonance", 0.8f}, {"release", 0.02f},
+        {"subLevel", 0.3f},  {"pwmDepth", 0.3f},   {"decay", 0.03f},
+        {"sustain", 0.6f},
+    };
+    for (const auto &p : params) {
+        ParamId id{};
+        ASSERT_TRUE(paramIdFromString(p.first, id));
+        bank.setParam(id, p.second);
+    }
+    for (int v = 0; v < numVoices; ++v) {
+        reference[v].initialize(sampleRate);
+        for (const auto &p : params) reference[v].setParam(p.first, p.second);
+        // Leave one voice idle to cover masked lanes.
+        if (v == 1) continue;
+        bank.noteOn(v, 40 + 5 * v, 0.5f + 0.05f * v);
+        reference[v].noteOn(40 + 5 * v, 0.5f + 0.05f * v);
+    }
+
+    const std::size_t stride = static_cast<std::size_t>(bufferSize) * 2;
+    std::vector<float> scratch(stride * bank.groupCount() * VoiceBank::kLanes, 0.0f);
+    std::vector<float> refL(bufferSize, 0.0f);
+    std::vector<float> refR(bufferSize, 0.0f);
+
+    // Mid-note automation so the lanes are compared while ramping.
+    const std::pair<const char *, float> automation[] = {
+        {"cutoff", 450.0f}, {"resonance", 0.3f}, {"pwmDepth", 0.7f}, {"subLevel", 0.6f},
+    };
+
+    double maxDiff = 0.0;
+    for (int b = 0; b < blocks; ++b) {
+        if (b == blocks / 6) {
+            for (const auto &p : automation) {
+                ParamId id{};
+                ASSERT_TRUE(paramIdFromString(p.first, id));
+                bank.setParam(id, p.second);
+                for (auto &voice : reference) voice.setParam(p.first, p.second);
+            }
+        }
+        if (b == blocks / 3) {
+            for (int v = 0; v < numVoices; v += 2) {
+                bank.noteOff(v, 40 + 5 * v);
+                reference[v].noteOff(40 + 5 * v);
+            }
+        }
+        for (int g = 0; g < bank.groupCount(); ++g) {
+            float *base = scratch.data() + g * VoiceBank::kLanes * stride;
+            bank.renderGroup(g, base, base + bufferSize, stride, bufferSize);
+        }
+        for (int v = 0; v < numVoices; ++v) {
+            reference[v].renderBlock(refL.data(), refR.data(), bufferSize);
+            const float *bl = scratch.data() + v * stride;
+            const float *br = bl + bufferSize;
+            for (int i = 0; i < bufferSize; ++i) {
+                maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(bl[i] - refL[i])));
+                maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(br[i] - refR[i])));
+            }
+            EXPECT_EQ(bank.isActive(v), reference[v].isActive());
+        }
+    }
+
+    EXPECT_LT(maxDiff, 1e-6);
+}
+
+TEST(Render, SharedChorusBusMatchesPerVoiceWhenChorusOff) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = TEST_POLYPHONY;
+    constexpr int blocks = 16;
+
+    JunoDSPEngine shared;
+    JunoDSPEngine perVoice;
+    perVoice.setChorusRouting(JunoDSPEngine::ChorusRouting::PerVoice);
+    shared.initialize(sampleRate, bufferSize, polyphony, false);
+    perVoice.initialize(sampleRate, bufferSize, polyphony, false);
+
+    for (JunoDSPEngine *e : {&shared, &perVoice}) {
+        // With the chorus off both routings reduce to the dry voice sum.
+        e->setParameter("chorusMode", 0.0f);
+        e->noteOn(48, 0.9f);
+        e->noteOn(55, 0.7f);
+        e->noteOn(64, 0.6f);
+    }
+
+    std::vector<float> leftA(bufferSize), rightA(bufferSize);
+    std::vector<float> leftB(bufferSize), rightB(bufferSize);
+
+    double maxDiff = 0.0;
+    double energy = 0.0;
+    for (int b = 0; b < blocks; ++b) {
+        shared.renderAudio(leftA.data(), rightA.data(), bufferSize);
+        perVoice.renderAudio(leftB.data(), rightB.data(), bufferSize);
+        for (int i = 0; i < bufferSize; ++i) {
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(leftA[i] - leftB[i])));
+            maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(rightA[i] - rightB[i])));
+            energy += static_cast<double>(leftA[i]) * leftA[i];
+        }
+    }
+
+    EXPECT_GT(energy, 0.0);
+    EXPECT_LT(maxDiff, 1e-6);
+}
+
+TEST(Render, WorkerThreadsAreBitIdentical) {
+    constexpr int sampleRate = TEST_SAMPLE_RATE;
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int polyphony = 32;
+    constexpr int blocks = 24;
+
+    JunoDSPEngine single;
+    JunoDSPEngine threaded;
+    threaded.setWorkerThreads(3);
+    single.initialize(sampleRate, bufferSize, polyphony, false);
+    threaded.initialize(sampleRate, bufferSize, polyphony, false);
+
+    for (JunoDSPEngine *e : {&single, &threaded}) {
+        e->setParameter("resonance", 0.7f);
+        for (int v = 0; v < polyphony; ++v) {
+            e->noteOn(36 + v, 0.3f + 0.02f * v);
+        }
+    }
+
+    std::vector<float> leftA(bufferSize), rightA(bufferSize);
+    std::vector<float> leftB(bufferSize), rightB(bufferSize);
+
+    bool identical = true;
+    double energy = 0.0;
+    for (int b = 0; b < blocks; ++b) {
+        if (b == blocks / 2) {
+            for (int v = 0; v < polyphony; v += 3) {
+                single.noteOff(36 + v);
+                threaded.noteOff(36 + v);
+            }
+        }
+        single.renderAudio(leftA.data(), rightA.data(), bufferSize);
+        threaded.renderAudio(leftB.data(), rightB.data(), bufferSize);
+        for (int i = 0; i < bufferSize; ++i) {
+            identical = identical && leftA[i] == leftB[i] && rightA[i] == rightB[i];
+            energy += static_cast<double>(leftA[i]) * leftA[i];
+        }
+    }
+
+    EXPECT_GT(energy, 0.0);
+    EXPECT_TRUE(identical);
+}
+
+// Between batches workers spin only briefly, then sleep until the next one,
+// so a pool with no work costs no CPU.
+TEST(Render, IdleWorkersPark) {
+    RenderThreadPool pool;
+    ASSERT_TRUE(pool.start(3));
+    std::atomic<int> done{0};
+    auto job = [](void *context, int) { static_cast<std::atomic<int> *>(context)->fetch_add(1); };
+    for (int b = 0; b < 8; ++b) pool.run(job, &done, 8);
+    EXPECT_EQ(done.load(), 64);
+
+    // Let the spin budget run out, then measure a stretch of idling.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const std::clock_t cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    EXPECT_LT(cpuMs, 20.0);
+
+    // Parked workers still pick up the next batch.
+    pool.run(job, &done, 8);
+    EXPECT_EQ(done.load(), 72);
+    pool.stop();
+}
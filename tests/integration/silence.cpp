@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "JunoDSPEngine.hpp"
+#include "JunoVoice.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+bool allZero(const std::vector<float> &v) {
+    return std::all_of(v.begin(), v.end(), [](float s) { return s == 0.0f; });
+}
+
+} // namespace
+
+TEST(Silence, IdleEngineReportsSilentBlocks) {
+    JunoDSPEngine engine;
+    engine.initialize(TEST_SAMPLE_RATE, TEST_BUFFER_SIZE, TEST_POLYPHONY, false);
+
+    std::vector<float> left(TEST_BUFFER_SIZE, 1.0f), right(TEST_BUFFER_SIZE, 1.0f);
+    EXPECT_TRUE(engine.renderAudio(left.data(), right.data(), TEST_BUFFER_SIZE));
+    EXPECT_TRUE(allZero(left));
+    EXPECT_TRUE(allZero(right));
+
+    // Stopped engines zero-fill too, so a callback can pass the flag on.
+    engine.stop();
+    std::fill(left.begin(), left.end(), 1.0f);
+    EXPECT_TRUE(engine.renderAudio(left.data(), right.data(), TEST_BUFFER_SIZE));
+    EXPECT_TRUE(allZero(left));
+}
+
+TEST(Silence, ChorusTailPlaysOutBeforeSilence) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+
+    JunoDSPEngine engine;
+    engine.initialize(TEST_SAMPLE_RATE, bufferSize, TEST_POLYPHONY, false);
+    engine.setParameter(ParamId::Release, 0.01f);
+    engine.setParameter(ParamId::ChorusMode, 1.0f);
+    engine.noteOn(60, 1.0f);
+
+    std::vector<float> left(bufferSize), right(bufferSize);
+    EXPECT_FALSE(engine.renderAudio(left.data(), right.data(), bufferSize));
+    engine.noteOff(60);
+
+    // Blocks reported audible after the release, until the first silent one.
+    int audibleBlocks = 0;
+    while (!engine.renderAudio(left.data(), right.data(), bufferSize)) {
+        ASSERT_LT(++audibleBlocks, 10 * TEST_SAMPLE_RATE / bufferSize);
+    }
+    EXPECT_TRUE(allZero(left));
+    EXPECT_TRUE(allZero(right));
+
+    // Covers the release plus the 50 ms chorus delay line.
+    EXPECT_GE(audibleBlocks * bufferSize, TEST_SAMPLE_RATE / 20);
+
+    for (int b = 0; b < 8; ++b) {
+        EXPECT_TRUE(engine.renderAudio(left.data(), right.data(), bufferSize));
+    }
+
+    // A new note wakes the engine up on the next block.
+    engine.noteOn(64, 0.8f);
+    EXPECT_FALSE(engine.renderAudio(left.data(), right.data(), bufferSize));
+    EXPECT_FALSE(allZero(left));
+}
+
+TEST(Silence, QuietVoicesRetireEarlier) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+
+    // Retirement follows the output level, so a soft note ends first.
+    auto blocksUntilRetired = [&](float velocity) {
+        JunoVoice voice;
+        voice.initialize(TEST_SAMPLE_RATE);
+        voice.setParam("release", 0.05f);
+        voice.noteOn(60, velocity);
+        std::vector<float> left(bufferSize), right(bufferSize);
+        for (int b = 0; b < 16; ++b) voice.renderBlock(left.data(), right.data(), bufferSize);
+        voice.noteOff(60);
+        int blocks = 0;
+        while (voice.isActive() && blocks < 10000) {
+            voice.renderBlock(left.data(), right.data(), bufferSize);
+            ++blocks;
+        }
+        return blocks;
+    };
+
+    EXPECT_LT(blocksUntilRetired(0.05f), blocksUntilRetired(1.0f));
+}
+
+TEST(Silence, IdleRenderCost) {
+    constexpr int bufferSize = TEST_BUFFER_SIZE;
+    constexpr int blocks = 2000;
+
+    JunoDSPEngine engine;
+    engine.initialize(TEST_SAMPLE_RATE, bufferSize, TEST_POLYPHONY, false);
+    std::vector<float> left(bufferSize), right(bufferSize);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; ++b) {
+        engine.renderAudio(left.data(), right.data(), bufferSize);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "[METRIC] Idle block render (us): "
+              << std::chrono::duration<double, std::micro>(end - start).count() / blocks
+              << std::endl;
+
+    SUCCEED();
+}
@@ -0,0 +1,217 @@
+#include "RtCheck.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <time.h>
+#endif
+
+namespace rtcheck {
+namespace {
+
+thread_local const char *tCallback = nullptr;   // set inside AudioCallback
+thread_local bool tProbing = false;             // active() is probing malloc
+thread_local bool tProbeHit = false;
+
+std::atomic<std::size_t> gCount{0};
+Violation gRecorded[kMaxRecorded];
+
+const char *kindName(Kind kind) {
+    switch (kind) {
+        case Kind::Allocation:   return "allocation";
+        case Kind::Deallocation: return "deallocation";
+        case Kind::Lock:         return "lock";
+        case Kind::Syscall:      return "syscall";
+    }
+    return "?";
+}
+
+} // namespace
+
+// Called by every interposer; must not allocate or lock.
+void record(Kind kind, const char *function) {
+    if (tProbing) tProbeHit = true;
+    const char *callback = tCallback;
+    if (!callback) return;
+    const std::size_t slot = gCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot < kMaxRecorded) gRecorded[slot] = {kind, function, callback};
+}
+
+AudioCallback::AudioCallback(const char *callback) { tCallback = callback; }
+AudioCallback::~AudioCallback() { tCallback = nullptr; }
+
+std::size_t count() { return gCount.load(std::memory_order_relaxed); }
+
+const Violation &at(std::size_t index) { return gRecorded[index]; }
+
+void reset() { gCount.store(0, std::memory_order_relaxed); }
+
+void report(std::ostream &os) {
+    const std::size_t n = count() < kMaxRecorded ? count() : kMaxRecorded;
+    for (std::size_t i = 0; i < n;) {
+        const Violation &v = gRecorded[i];
+        std::size_t repeats = 1;
+        while (i + repeats < n && gRecorded[i + repeats].kind == v.kind &&
+               std::strcmp(gRecorded[i + repeats].function, v.function) == 0 &&
+               std::strcmp(gRecorded[i + repeats].callback, v.callback) == 0) {
+            ++repeats;
+        }
+        os << "[RT] " << kindName(v.kind) << " " << v.function << " in " << v.callback;
+        if (repeats > 1) os << " (x" << repeats << ")";
+        os << "\n";
+        i += repeats;
+    }
+    if (count() > n) os << "[RT] ... " << count() - n << " more not recorded\n";
+}
+
+bool active() {
+    tProbing = true;
+    tProbeHit = false;
+    // volatile keeps the compiler from pairing and eliding the calls.
+    void *(*volatile allocate)(std::size_t) = &::malloc;
+    ::free(allocate(1));
+    tProbing = false;
+    return tProbeHit;
+}
+
+} // namespace rtcheck
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+// ============================================================
+// Interposers. Defined in the executable, they take precedence over libc
+// for every caller, libstdc++'s operator new included. The allocator
+// forwards to glibc's __libc_* entry points; everything else to the next
+// definition, looked up once at startup.
+// ============================================================
+
+extern "C" {
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void *__libc_memalign(size_t, size_t);
+void __libc_free(void *);
+}
+
+namespace {
+
+using MutexLockFn = int (*)(pthread_mutex_t *);
+using ReadWriteFn = ssize_t (*)(int, void *, size_t);
+using WriteFn = ssize_t (*)(int, const void *, size_t);
+using NanosleepFn = int (*)(const struct timespec *, struct timespec *);
+using ClockNanosleepFn = int (*)(clockid_t, int, const struct timespec *, struct timespec *);
+using UsleepFn = int (*)(useconds_t);
+using YieldFn = int (*)();
+
+MutexLockFn realMutexLock;
+ReadWriteFn realRead;
+WriteFn realWrite;
+NanosleepFn realNanosleep;
+ClockNanosleepFn realClockNanosleep;
+UsleepFn realUsleep;
+YieldFn realYield;
+
+template <typename Fn>
+Fn next(Fn &slot, const char *name) {
+    if (!slot) slot = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+    return slot;
+}
+
+__attribute__((constructor(101))) void resolveNext() {
+    next(realMutexLock, "pthread_mutex_lock");
+    next(realRead, "read");
+    next(realWrite, "write");
+    next(realNanosleep, "nanosleep");
+    next(realClockNanosleep, "clock_nanosleep");
+    next(realUsleep, "usleep");
+    next(realYield, "sched_yield");
+}
+
+using rtcheck::Kind;
+using rtcheck::record;
+
+} // namespace
+
+extern "C" {
+
+void *malloc(size_t size) {
+    record(Kind::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    record(Kind::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    record(Kind::Allocation, "realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    record(Kind::Allocation, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    record(Kind::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) {
+    record(Kind::Allocation, "posix_memalign");
+    void *p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void free(void *ptr) {
+    if (ptr) record(Kind::Deallocation, "free");
+    __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t *mutex) {
+    record(Kind::Lock, "pthread_mutex_lock");
+    return next(realMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+ssize_t read(int fd, void *buf, size_t n) {
+    record(Kind::Syscall, "read");
+    return next(realRead, "read")(fd, buf, n);
+}
+
+ssize_t write(int fd, const void *buf, size_t n) {
+    record(Kind::Syscall, "write");
+    return next(realWrite, "write")(fd, buf, n);
+}
+
+int nanosleep(const struct timespec *duration, struct timespec *remaining) {
+    record(Kind::Syscall, "nanosleep");
+    return next(realNanosleep, "nanosleep")(duration, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec *request,
+                    struct timespec *remaining) {
+    record(Kind::Syscall, "clock_nanosleep");
+    return next(realClockNanosleep, "clock_nanosleep")(clock, flags, request, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+    record(Kind::Syscall, "usleep");
+    return next(realUsleep, "usleep")(microseconds);
+}
+
+int sched_yield() {
+    record(Kind::Syscall, "sched_yield");
+    return next(realYield, "sched_yield")();
+}
+
+} // extern "C"
+
+#endif
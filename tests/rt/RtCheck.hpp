@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+// Realtime-safety checker for the render paths (Linux, test binaries only).
+//
+// RtCheck.cpp interposes malloc and friends, pthread_mutex_lock and the
+// sleeping/IO syscalls a render call could reach. Outside an AudioCallback
+// scope the interposers only forward; inside one, on that thread, every call
+// is recorded as a violation before forwarding, so a run shows everything
+// the callback did rather than stopping at the first. Recording itself
+// never allocates or locks.
+//
+// Not seen: condition-variable wake-ups (a futex, but pthread_cond_* are
+// versioned symbols) and libc's internal calls, e.g. stdio's own write().
+namespace rtcheck {
+
+enum class Kind { Allocation, Deallocation, Lock, Syscall };
+
+struct Violation {
+    Kind kind;
+    const char *function;   // the interposed call, e.g. "malloc"
+    const char *callback;   // the AudioCallback scope it happened in
+};
+
+// Marks the calling thread as inside `callback` (e.g. "renderAudio") for
+// the scope's lifetime. Scopes do not nest.
+class AudioCallback {
+public:
+    explicit AudioCallback(const char *callback);
+    ~AudioCallback();
+    AudioCallback(const AudioCallback &) = delete;
+    AudioCallback &operator=(const AudioCallback &) = delete;
+};
+
+// Violations since the last reset(); only the first kMaxRecorded are kept,
+// count() keeps counting.
+constexpr std::size_t kMaxRecorded = 64;
+std::size_t count();
+const Violation &at(std::size_t index);
+void reset();
+
+// One line per recorded violation, with repeats of the same call folded.
+void report(std::ostream &os);
+
+// False if the interposers are not linked in (e.g. a non-glibc platform),
+// in which case nothing can be detected.
+bool active();
+
+} // namespace rtcheck
@@ -0,0 +1,105 @@
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "RtCheck.hpp"
+#include "engine/JunoEngine.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+namespace {
+
+constexpr double kSeconds = 5.0;
+
+// One valid .106 sysex message; `p` varies the sliders.
+std::vector<uint8_t> sysexPatch(int p) {
+    std::vector<uint8_t> msg(Juno106::SYSEX_MESSAGE_SIZE, 0);
+    msg[0] = Juno106::SYSEX_START;
+    msg[1] = Juno106::ROLAND_ID;
+    msg[2] = 0x30;
+    msg[3] = static_cast<uint8_t>(p & 0x7F);
+    uint32_t sum = 0;
+    for (int i = 5; i <= 22; ++i) {
+        msg[i] = static_cast<uint8_t>((p * 7 + i * 13) & 0x7F);
+        sum += msg[i];
+    }
+    msg[23] = static_cast<uint8_t>((128 - (sum & 0x7F)) & 0x7F);
+    msg[24] = Juno106::SYSEX_END;
+    return msg;
+}
+
+// The engine_matrix workloads in JunoEngine terms, all in one script so
+// every control path is live at once: a stealing arpeggio over the six
+// voices, a per-block cutoff sweep, a patch load every 250 ms, chorus
+// mode and oversampling changes every second and a long release.
+void controlSide(JunoEngine &engine, int block, int frames) {
+    const int sr = TEST_SAMPLE_RATE;
+    const std::int64_t start = static_cast<std::int64_t>(block) * frames;
+    const std::int64_t end = start + frames;
+    // True if a multiple of `period` falls in this block.
+    auto crosses = [&](std::int64_t period) { return (end - 1) / period * period >= start; };
+
+    const std::int64_t step = sr * 60 / 1000;
+    if (crosses(step)) {
+        const std::int64_t k = (end - 1) / step;
+        engine.noteOn(48 + static_cast<int>((k * 5) % 24), 0.8f);
+        if (k >= 8) engine.noteOff(48 + static_cast<int>(((k - 8) * 5) % 24));
+    }
+
+    VoiceParams p;
+    const double s = static_cast<double>(start) / sr;
+    p.cutoffHz = static_cast<float>(100.0 * std::pow(120.0, 0.5 + 0.5 * std::sin(2.0 * 3.14159265358979 * s / 1.5)));
+    p.resonance = 0.6f;
+    p.envRelease = 3.0f;
+    engine.setVoiceParams(p);
+
+    if (crosses(sr / 4)) {
+        const std::vector<uint8_t> patch = sysexPatch(static_cast<int>(start / (sr / 4)));
+        engine.loadJuno106Sysex(patch.data(), patch.size());
+    }
+    if (crosses(sr)) {
+        const int second = static_cast<int>(start / sr);
+        engine.setChorusMode(second % 3);
+        engine.setOversampling(second % 2 == 0 ? 1 : 2);
+    }
+}
+
+} // namespace
+
+TEST(AnalogRtSafety, RenderIsFreeOfAllocationsLocksAndSyscalls) {
+    ASSERT_TRUE(rtcheck::active()) << "allocation interposer not linked in";
+    const int n = TEST_BUFFER_SIZE;
+    const std::pair<AnalogTier, const char *> tiers[] = {
+        {AnalogTier::Eco, "eco"},
+        {AnalogTier::Standard, "standard"},
+        {AnalogTier::Ultra, "ultra"},
+    };
+    for (const auto &tier : tiers) {
+        JunoEngine engine;
+        engine.init(TEST_SAMPLE_RATE);
+        engine.setAnalogTier(tier.first);
+        std::vector<float> left(static_cast<std::size_t>(n)), right(left.size());
+
+        rtcheck::reset();
+        const int blocks = static_cast<int>(kSeconds * TEST_SAMPLE_RATE / n);
+        for (int b = 0; b < blocks; ++b) {
+            controlSide(engine, b, n);
+            rtcheck::AudioCallback scope("JunoEngine::render");
+            engine.render(left.data(), right.data(), n);
+        }
+
+        rtcheck::report(std::cout);
+        std::cout << "[METRIC] rt_violations engine=analog_" << tier.second
+                  << " count=" << rtcheck::count() << std::endl;
+        EXPECT_EQ(rtcheck::count(), 0u) << tier.second;
+    }
+    rtcheck::reset();
+}
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EngineWorkloads.hpp"
+#include "JunoDSPEngine.hpp"
+#include "RtCheck.hpp"
+
+#ifndef TEST_SAMPLE_RATE
+#define TEST_SAMPLE_RATE 44100
+#endif
+
+#ifndef TEST_BUFFER_SIZE
+#define TEST_BUFFER_SIZE 128
+#endif
+
+#ifndef TEST_POLYPHONY
+#define TEST_POLYPHONY 8
+#endif
+
+namespace {
+
+// Audio rendered per workload; long enough for every script to repeat
+// (chords change every 2 s, stabs every 1.5 s).
+constexpr double kSeconds = 5.0;
+
+bool sawKind(rtcheck::Kind kind) {
+    const std::size_t n = std::min(rtcheck::count(), rtcheck::kMaxRecorded);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (rtcheck::at(i).kind == kind) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// The interposers must be live, or the engine tests below prove nothing.
+TEST(RtSafety, CheckerSeesAllocationsLocksAndSleeps) {
+    ASSERT_TRUE(rtcheck::active()) << "allocation interposer not linked in";
+    rtcheck::reset();
+    std::mutex mutex;
+    {
+        rtcheck::AudioCallback scope("self_test");
+        std::vector<float> scratch(64, 1.0f);
+        EXPECT_EQ(scratch.size(), 64u);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::this_thread::sleep_for(std::chrono::microseconds(1));
+    }
+    EXPECT_TRUE(sawKind(rtcheck::Kind::Allocation));
+    EXPECT_TRUE(sawKind(rtcheck::Kind::Deallocation));
+    EXPECT_TRUE(sawKind(rtcheck::Kind::Lock));
+    EXPECT_TRUE(sawKind(rtcheck::Kind::Syscall));
+
+    // Other threads, and this one outside the scope, are not checked.
+    rtcheck::reset();
+    std::atomic<int> phase{0};
+    std::thread other([&] {
+        while (phase.load() != 1) {}
+        std::vector<float> elsewhere(64);
+        phase.store(2);
+    });
+    {
+        rtcheck::AudioCallback scope("self_test");
+        phase.store(1);
+        while (phase.load() != 2) {}
+    }
+    other.join();
+    std::vector<float> outside(64);
+    EXPECT_EQ(rtcheck::count(), 0u);
+    rtcheck::reset();
+}
+
+// Every engine_matrix workload, with notes, parameter changes and patch
+// loads issued from the control side between callbacks, must render
+// without touching the allocator, a lock or a blocking syscall.
+TEST(RtSafety, EngineWorkloadsRenderWithoutViolations) {
+    ASSERT_TRUE(rtcheck::active());
+    const int n = TEST_BUFFER_SIZE;
+    for (const auto &w : engine_workloads::workloads(TEST_SAMPLE_RATE, TEST_POLYPHONY)) {
+        JunoDSPEngine engine;
+        engine.initialize(TEST_SAMPLE_RATE, n, TEST_POLYPHONY, false);
+        engine.start();
+        w.setup(engine);
+        std::vector<float> left(static_cast<std::size_t>(n)), right(left.size());
+        engine_workloads::Timeline timeline{engine, engine.currentSampleTime()};
+
+        rtcheck::reset();
+        const int blocks = static_cast<int>(kSeconds * TEST_SAMPLE_RATE / n);
+        for (int b = 0; b < blocks; ++b) {
+            w.script(timeline, static_cast<std::int64_t>(b) * n, n);
+            rtcheck::AudioCallback scope("JunoDSPEngine::renderAudio");
+            engine.renderAudio(left.data(), right.data(), n);
+        }
+        engine.stop();
+
+        rtcheck::report(std::cout);
+        std::cout << "[METRIC] rt_violations engine=rtn workload=" << w.name
+                  << " count=" << rtcheck::count() << std::endl;
+        EXPECT_EQ(rtcheck::count(), 0u) << w.name;
+    }
+    rtcheck::reset();
+}